@@ -1,27 +1,56 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
 #include "hardware/pwm.h"
+#include "hardware/clocks.h"
 #include "inc/ssd1306.h"
 #include "inc/assets.h"
+#include "inc/http_body.h"
 #include "pico/cyw43_arch.h"
 #include "lwip/pbuf.h"
 #include "lwip/tcp.h"
+#include "lwip/altcp_tcp.h"
+#include "lwip/altcp_tls.h"
 #include "lwip/apps/http_client.h"
+#include "mbedtls/ssl.h"
+#include "mbedtls/memory_buffer_alloc.h"
+#include "inc/mem_report.h"
+#include "inc/input.h"
+#include "inc/temp_sensor.h"
+#include "inc/forecast.h"
+#include "inc/status_screens.h"
+#include "inc/http_request.h"
+#include "inc/response_buffer.h"
+#ifdef TLS_STANDIN
+#include "tls_standin.h"    // Gerado por tools/tls_standin.sh: servidor local e a raiz dele
+#else
+#include "inc/root_ca.h"
+#endif
+#ifdef HAVE_STATUS_FRAMES
+#include "status_frames.h"  // Gerado na compilação por tools/gen_status_frames.c
+#endif
 
 void extract_data_from_response();
 bool setup();
 void display_screens(uint screen);
+void status_show_blocking(int status);
+bool status_step();
 bool connect_wifi(char* SSID, char* PASSWORD);
-static err_t http_response_callback(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err);
-static err_t http_sent_callback(void *arg, struct tcp_pcb *tpcb, u16_t len);
-static err_t http_connected_callback(void *arg, struct tcp_pcb *tpcb, err_t err);
-void http_request_init();
-void extract_data_from_response();
-bool debounce();
-void buttons_handler(uint gpio, uint32_t events);
+static struct altcp_pcb *request_open(request_kind_t kind);
+static void request_connected(struct altcp_pcb *tpcb, request_kind_t kind);
+static bool request_received(struct altcp_pcb *tpcb, request_kind_t kind, struct pbuf *p);
+static void request_finished(request_kind_t kind, request_result_t result);
+static err_t http_sent_callback(void *arg, struct altcp_pcb *tpcb, u16_t len);
+void handle_input(const input_event_t *event);
+void update_local_temperature();
+void update_interpolated_weather();
+void format_centi(char *out, size_t size, int32_t centi);
+#if USE_TLS && TLS_BENCHMARK_ROUNDS > 0
+void tls_benchmark_step();
+#endif
 
 // Pinos do display OLED
 #define I2C_PORT i2c1
@@ -36,15 +65,58 @@ void buttons_handler(uint gpio, uint32_t events);
 #define BUTTON_B 6
 #define JYSTCK_BTTN 22
 
-// Constantes auxiliares (Buffer e PWM)
-#define BUFFER_SIZE 1024
+// Constantes auxiliares (PWM)
 #define WRAP 50000
 #define DIV 16.0
 #define STEP_LED (0.250 * WRAP) / 100.0
+#define LOCAL_TEMP_MS 1000     // Intervalo entre leituras do sensor interno
+#define TEMP_DISAGREE_CENTI 500 // Diferença (em centésimos de grau) para sinalizar divergência com a API
+#define INTERPOLATION_MS 10000  // Intervalo entre atualizações locais da temperatura pela previsão
+#define FORECAST_RETRY_MS (5 * 60 * 1000) // Intervalo mínimo entre tentativas de buscar a previsão
+#define STATUS_HOLD_MS 300 // Tempo mínimo de cada tela de status no display (sem bloquear o laço)
+#define STATUS_QUEUE_SIZE 4 // Telas de status aguardando a anterior cumprir o tempo (potência de 2)
+#define LED_STEP_MS 300 // Intervalo entre passos do fade (mantém o ritmo de quando o laço redesenhava sempre)
 
 // Buffer para armazenar a resposta da requisição HTTP
-static char response_buffer[BUFFER_SIZE] = {0};  
-static size_t response_index = 0;  // Índice atual do buffer -> auxiliar a percorrer o buffer
+
+// Decodificador da resposta (cabeçalhos, chunked, gzip/deflate) -> entrega o corpo no response_buffer
+static http_body_t response_body;
+static bool compression_enabled = true; // Desativada se o servidor mandar algo que não cabe na janela
+static uint32_t decode_time_us = 0;     // Tempo gasto decodificando a resposta atual
+
+// Ganchos do gerenciador de requisições (inc/http_request.c): prazos e requisição única ficam lá
+static const http_request_hooks_t request_hooks = {
+    .open = request_open,
+    .connected = request_connected,
+    .received = request_received,
+    .finished = request_finished,
+};
+
+#if USE_TLS
+// Configuração TLS do cliente (criada uma única vez, no setup) e sessão guardada para retomada.
+// O servidor é autenticado pela raiz em ROOT_CA_DER (handshake falha se a cadeia ou o nome
+// não conferirem). Com a sessão (ticket ou session ID) o próximo handshake pula a troca
+// ECDHE e a verificação RSA da cadeia, que são a maior parte do custo de CPU no RP2040.
+static struct altcp_tls_config *tls_config = NULL;
+static struct altcp_tls_session *tls_session = NULL; // API de sessão do altcp_tls (heap do lwIP)
+static bool tls_session_valid = false;
+static bool tls_session_offered = false;
+
+// Arena estática de onde o mbedTLS aloca contexto, buffers de registro e a cadeia recebida
+#define TLS_ARENA_SIZE (40 * 1024)
+static unsigned char tls_arena[TLS_ARENA_SIZE];
+#endif
+static absolute_time_t connect_start; // Instante do altcp_connect -> mede o tempo do handshake
+
+#if USE_TLS && TLS_BENCHMARK_ROUNDS > 0
+// Benchmark do handshake: alterna completo (sessão descartada) e retomado; índice 0 = completo
+static uint32_t bench_started = 0;
+static bool bench_measuring = false;   // A requisição atual é do benchmark e ainda não conectou
+static bool bench_resumed = false;
+static uint32_t bench_count[2] = {0};
+static int64_t bench_total_us[2] = {0};
+static size_t bench_peak[2] = {0};
+#endif
 
 // Variavel de cntrole de aumento e diminuição do brilho dos LEDs
 bool increase = true;
@@ -53,34 +125,90 @@ bool increase = true;
 char weather_description[100] = {0};
 char temperature[10] = {0};
 char feels_like[10] = {0};
+int32_t api_temperature_centi = 0;
+int32_t api_feels_like_centi = 0;
+bool api_temperature_valid = false;
+
+// Relógio Unix estimado a partir do "dt" da observação (segundos desde o boot + deslocamento)
+uint32_t epoch_offset = 0;
+bool epoch_valid = false;
+absolute_time_t last_interpolation;
+uint32_t local_updates = 0;     // Atualizações de tela feitas pela previsão, sem rede
+
+// Temperatura local (sensor interno do RP2040) e sinalização de divergência com a API
+char local_temperature[10] = {0};
+bool temperature_disagrees = false;
+absolute_time_t last_local_temp;
 
 // Variáveis para controle de tempo, tela do display e brilho dos LEDs
-uint last_time = 0;
 uint screen = 7;
+volatile uint shown_screen = -1;    // Última tela enviada ao display
+volatile bool display_dirty = true; // Dados do clima mudaram -> redesenhar a tela atual
+absolute_time_t status_hold_until;  // Tela de status fica visível até aqui antes de ser coberta
+
+// Fila das telas de status pedidas pelos callbacks do lwIP (produtor, sob o lock do lwIP) e
+// enviadas pelo laço principal (consumidor), uma a cada STATUS_HOLD_MS
+static volatile int8_t status_queue[STATUS_QUEUE_SIZE];
+static volatile uint8_t status_queue_head = 0, status_queue_tail = 0;
+absolute_time_t last_led_step;
 uint16_t red_led_level = 0;
 uint16_t blue_led_level = WRAP;
 
 ssd1306_t ssd; // Estrutura do display OLED
 
 int main() {
+    mem_report_init(); // Pinta a pilha livre para medir a marca d'água
     stdio_init_all();
     if (!setup() || !connect_wifi(SSID, PASSWORD)) {
-        display_screens(3);
+        status_show_blocking(3);
         sleep_ms(2000);
         return -1;
     }
+    mem_report_end_init(); // Daqui em diante nenhuma alocação deve vir do heap
 
-    http_request_init(); // Inicializa a requisição HTTP
+    cyw43_arch_lwip_begin();
+    http_request_start(REQUEST_WEATHER); // Inicializa a requisição HTTP (a previsão vem em seguida)
+    cyw43_arch_lwip_end();
 
     sleep_ms(2000); // pausa pra dar tempo de receber a resposta e atualizar variáveis de informação do clima
 
-    gpio_set_irq_enabled_with_callback(BUTTON_A, GPIO_IRQ_EDGE_FALL, true, &buttons_handler);
-    gpio_set_irq_enabled_with_callback(BUTTON_B, GPIO_IRQ_EDGE_FALL, true, &buttons_handler);
-    gpio_set_irq_enabled_with_callback(JYSTCK_BTTN, GPIO_IRQ_EDGE_FALL, true, &buttons_handler);
+    static const uint buttons[] = {BUTTON_A, BUTTON_B, JYSTCK_BTTN};
+    input_init(buttons, 3); // Bordas via IRQ, debounce no timer, eventos consumidos abaixo
 
     while (true) {
         cyw43_arch_poll();  // Polling do módulo WiFi -> necessário para manter a conexão
-        display_screens(screen);
+
+        input_event_t event;
+        while (input_poll(&event)) {
+            handle_input(&event);
+        }
+
+        // Redesenha só quando a tela ou os dados mudam -> o laço continua respondendo aos botões.
+        // Telas de status na fila (ou ainda no tempo mínimo) têm a vez antes do redesenho.
+        if (!status_step() && (screen != shown_screen || display_dirty)) {
+            display_dirty = false;
+            display_screens(screen);
+        }
+
+#if USE_TLS && TLS_BENCHMARK_ROUNDS > 0
+        tls_benchmark_step();
+#endif
+
+        if (absolute_time_diff_us(last_local_temp, get_absolute_time()) >= LOCAL_TEMP_MS * 1000) {
+            last_local_temp = get_absolute_time();
+            update_local_temperature();
+        }
+
+        if (absolute_time_diff_us(last_interpolation, get_absolute_time()) >= INTERPOLATION_MS * 1000) {
+            last_interpolation = get_absolute_time();
+            update_interpolated_weather();
+        }
+
+        sleep_ms(10);
+        if (absolute_time_diff_us(last_led_step, get_absolute_time()) < LED_STEP_MS * 1000) {
+            continue;
+        }
+        last_led_step = get_absolute_time();
 
         pwm_set_gpio_level(RED_LED, red_led_level);
         pwm_set_gpio_level(BLUE_LED, blue_led_level);
@@ -97,7 +225,6 @@ int main() {
                 increase = true;
             }
         }
-        sleep_ms(10);
     }
 }
 
@@ -118,6 +245,15 @@ void toUpperString(char *str) {
     }
 }
 
+#if USE_TLS
+// Função que retorna o pico de uso da arena do mbedTLS
+static size_t tls_arena_high_water() {
+    size_t max_used, max_blocks;
+    mbedtls_memory_buffer_alloc_max_get(&max_used, &max_blocks);
+    return max_used;
+}
+#endif
+
 // Função inicializar os pinos
 bool setup(){
     init_gpio_pwm(RED_LED); // Inicializa o pino do LED vermelho
@@ -135,13 +271,14 @@ bool setup(){
     gpio_pull_up(BUTTON_B); // Habilita o pull-up do botão B
     gpio_pull_up(JYSTCK_BTTN); // Habilita o pull-up do botão do joystick
 
-    i2c_init(I2C_PORT, 400*5000); // Inicializa o barramento I2C
+    i2c_init(I2C_PORT, 100*1000); // Inicializa o barramento I2C na velocidade mais segura
     gpio_set_function(I2C_SDA, GPIO_FUNC_I2C); // Define os pinos SDA e SCL
     gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
     gpio_pull_up(I2C_SDA); // Habilita os pull-ups
     gpio_pull_up(I2C_SCL);
     ssd1306_init(&ssd, WIDTH, HEIGHT, false, ADDRESS, I2C_PORT); // Inicializa o display OLED
     ssd1306_config(&ssd);   // Configura o display OLED
+    printf("I2C calibrado em %lu Hz\n", ssd1306_calibrate(&ssd)); // Maior velocidade confiável
     ssd1306_send_data(&ssd); // Envia os dados para o display
     
     ssd1306_fill(&ssd, false); // Limpa o display
@@ -158,49 +295,99 @@ bool setup(){
         return false;
     }
 
-    display_screens(-1);
+#if USE_TLS
+    // Com MBEDTLS_PLATFORM_MEMORY o lwIP troca o alocador do mbedTLS pelo heap dele (mem_malloc)
+    // ao criar a configuração. Por isso ela é criada aqui, antes da arena: só a raiz, que vive
+    // para sempre, fica no heap do lwIP, e a arena instalada em seguida recebe todo o resto.
+    cyw43_arch_lwip_begin();
+    tls_config = altcp_tls_create_config_client(ROOT_CA_DER, sizeof(ROOT_CA_DER));
+    cyw43_arch_lwip_end();
+    if (tls_config == NULL) {
+        printf("Falha ao criar configuracao TLS\n");
+        return false;
+    }
+    tls_session = altcp_tls_alloc_session(); // Sem ela só não há retomada
+    mbedtls_memory_buffer_alloc_init(tls_arena, sizeof(tls_arena));
+    mem_report_add_arena("mbedtls", sizeof(tls_arena), tls_arena_high_water);
+#endif
+    mem_report_add_arena("resposta", RESPONSE_BUFFER_SIZE, response_buffer_high_water);
+
+    static ip_addr_t server_ip;
+    if (!ipaddr_aton(SERVER_IP, &server_ip)) { // Converte o endereço IP para o formato correto
+        printf("Erro ao converter endereço IP\n");
+        return false;
+    }
+    http_request_init(&request_hooks, &server_ip, SERVER_PORT);
+
+    temp_sensor_init(); // ADC + DMA em segundo plano para a temperatura local
+
+    status_show_blocking(-1);
 
     return true;
 }
 
+// Função para enviar uma tela de status: texto fixo, enviado pronto em vez de redesenhado
+static void status_send(int status) {
+    int index = status - STATUS_SCREEN_FIRST;
+    shown_screen = (uint)status;
+#ifdef HAVE_STATUS_FRAMES
+    ssd1306_send_frame(&ssd, status_frames[index]); // Direto da flash (XIP), sem cópia
+#else
+    status_screen_render(&ssd, index);
+    ssd1306_send_data(&ssd);
+#endif
+    status_hold_until = make_timeout_time_ms(STATUS_HOLD_MS);
+}
+
+// Função para mostrar uma tela de status fora do laço principal (setup, conexão WiFi): espera a
+// anterior cumprir STATUS_HOLD_MS e envia na hora
+void status_show_blocking(int status) {
+    sleep_until(status_hold_until);
+    status_send(status);
+}
+
+// Função do laço principal: envia a próxima tela de status da fila quando a anterior cumpriu
+// STATUS_HOLD_MS. Retorna true enquanto houver tela de status na fila ou no tempo mínimo.
+bool status_step() {
+    if (absolute_time_diff_us(status_hold_until, get_absolute_time()) < 0) {
+        return true;
+    }
+    if (status_queue_tail == status_queue_head) {
+        return false;
+    }
+    status_send(status_queue[status_queue_tail % STATUS_QUEUE_SIZE]);
+    status_queue_tail++;
+    return true;
+}
+
+// Função para enfileirar uma tela de status (callbacks do lwIP, que não podem esperar o tempo
+// mínimo nem disputar o I2C com o laço). Repetições da tela mais recente são ignoradas; com a
+// fila cheia, a última posição passa a ser a tela nova.
+static void status_queue_push(int status) {
+    uint8_t head = status_queue_head;
+    int newest = head != status_queue_tail ? status_queue[(uint8_t)(head - 1) % STATUS_QUEUE_SIZE] : (int)shown_screen;
+    if (status == newest) {
+        return;
+    }
+    if ((uint8_t)(head - status_queue_tail) == STATUS_QUEUE_SIZE) {
+        status_queue[(uint8_t)(head - 1) % STATUS_QUEUE_SIZE] = status;
+        return;
+    }
+    status_queue[head % STATUS_QUEUE_SIZE] = status;
+    status_queue_head = head + 1;
+}
+
 // Função para tratar a tela exibida no display
 void display_screens(uint screen){
+    if ((int)screen >= STATUS_SCREEN_FIRST && (int)screen <= STATUS_SCREEN_LAST) {
+        status_queue_push((int)screen);
+        return;
+    }
+
+    shown_screen = screen;
     ssd1306_fill(&ssd, false);
 
     switch (screen){
-        case -1:
-            ssd1306_draw_string(&ssd, "PROJETO", 3, 15);
-            ssd1306_draw_string(&ssd, "FINAL", 3, 30);
-            ssd1306_draw_string(&ssd, "EMBARCATECH", 3, 45);
-            break;
-        case 0:
-            ssd1306_draw_string(&ssd, "CONECTANDO A", 3, 20);
-            ssd1306_draw_string(&ssd, SSID, 3, 35);
-            break;
-        case 1:
-            ssd1306_draw_string(&ssd, "CONECTADO A", 3, 20);
-            ssd1306_draw_string(&ssd, SSID, 3, 35);
-            break;
-        case 2:
-            ssd1306_draw_string(&ssd, "ERRO", 50, 20);
-            ssd1306_draw_string(&ssd, "AO CONECTAR", 20, 35);
-            break;
-        case 3:
-            ssd1306_draw_string(&ssd, "ERRO", 50, 20);
-            ssd1306_draw_string(&ssd, "AO INICIAR", 20, 35);
-            break;
-        case 4:
-            ssd1306_draw_string(&ssd, "REQUISITANDO", 3, 20);
-            ssd1306_draw_string(&ssd, "DADOS", 30, 35);
-            break;
-        case 5:
-            ssd1306_draw_string(&ssd, "DADOS", 3, 20);
-            ssd1306_draw_string(&ssd, "RECEBIDOS", 3, 35);
-            break;
-        case 6:
-            ssd1306_draw_string(&ssd, "TRATANDO", 3, 20);
-            ssd1306_draw_string(&ssd, "DADOS", 3, 35);
-            break;
         case 7:
             ssd1306_draw_string(&ssd, "TEMPERATURA", 3, 20);
             ssd1306_draw_string(&ssd, temperature, 3, 35);
@@ -213,7 +400,14 @@ void display_screens(uint screen){
         case 9:
             ssd1306_draw_string(&ssd, "TEMPO", 3, 20);
             ssd1306_draw_string(&ssd, weather_description, 3, 35);
-            break;    
+            break;
+        case 10:
+            ssd1306_draw_string(&ssd, "TEMP LOCAL", 3, 20);
+            ssd1306_draw_string(&ssd, local_temperature, 3, 35);
+            if (temperature_disagrees) {
+                ssd1306_draw_string(&ssd, "DIFERE DA API", 3, 50);
+            }
+            break;
         };
     ssd1306_send_data(&ssd);
     sleep_ms(300);
@@ -223,82 +417,196 @@ void display_screens(uint screen){
 bool connect_wifi(char* SSID, char* PASSWORD){
     cyw43_arch_enable_sta_mode(); // Habilita o modo estação
 
-    display_screens(0);
+    status_show_blocking(0);
 
     if(cyw43_arch_wifi_connect_timeout_ms(SSID, PASSWORD, CYW43_AUTH_WPA3_WPA2_AES_PSK, 10000)){ // Tenta a coneeção com a rede WiFi - timeout de 10s
         printf("Erro ao conectar a rede WiFi\n"); // Caso utilize um monitor serial
 
-       display_screens(2);
+       status_show_blocking(2);
 
         return false;
     }
 
-    display_screens(1);
+    status_show_blocking(1);
 
     printf("Conectado a rede WiFi\n"); // Caso utilize um monitor serial
     return true;
 }
 
-// Função de callback pque lida com a resposta HTTP
-static err_t http_response_callback(void *arg, struct tcp_pcb *tpcb, struct pbuf *p, err_t err) {
+#if USE_TLS
+// Função para guardar a sessão TLS da conexão atual para a próxima requisição
+static void tls_session_save(struct altcp_pcb *tpcb) {
+    if (tls_session == NULL) {
+        tls_session = altcp_tls_alloc_session(); // Só depois de um descarte
+    }
+    tls_session_valid = tls_session != NULL && altcp_tls_get_session(tpcb, tls_session) == ERR_OK;
+}
+
+// Função para descartar a sessão guardada (ex.: servidor recusou a retomada); o ticket volta à arena
+static void tls_session_discard() {
+    if (tls_session != NULL) {
+        altcp_tls_free_session(tls_session);
+        tls_session = NULL;
+    }
+    tls_session_valid = false;
+}
+#endif
+
+// Função do gancho open: cria a conexão (TLS ou TCP) e zera o decodificador e o buffer da resposta
+static struct altcp_pcb *request_open(request_kind_t kind) {
+    struct altcp_pcb *pcb;
+#if USE_TLS
+    pcb = altcp_tls_new(tls_config, IPADDR_TYPE_V4);
+#else
+    pcb = altcp_tcp_new_ip_type(IPADDR_TYPE_V4);
+#endif
+    if (pcb == NULL) {
+        printf("Falha ao criar PCB TCP\n");
+        return NULL;
+    }
+#if USE_TLS
+    mbedtls_ssl_context *ssl = (mbedtls_ssl_context *)altcp_tls_context(pcb);
+    mbedtls_ssl_set_hostname(ssl, URL); // SNI -> necessário para o servidor escolher o certificado
+    tls_session_offered = tls_session_valid && altcp_tls_set_session(pcb, tls_session) == ERR_OK;
+#endif
+    // Cada resposta começa com o decodificador e o buffer zerados; a previsão é extraída enquanto chega
+    if (kind == REQUEST_FORECAST) {
+        forecast_begin();
+        http_body_init(&response_body, forecast_sink, NULL);
+    } else {
+        http_body_init(&response_body, response_sink, NULL);
+    }
+    response_buffer_reset();
+    decode_time_us = 0;
+    connect_start = get_absolute_time();
+    return pcb;
+}
+
+// Função do gancho connected: conexão pronta (no HTTPS, após o handshake) -> envia a requisição
+static void request_connected(struct altcp_pcb *tpcb, request_kind_t kind) {
+    int64_t handshake_us = absolute_time_diff_us(connect_start, get_absolute_time());
+#if USE_TLS
+    printf("Handshake TLS em %lld ms (sessao %s)\n", handshake_us / 1000,
+           tls_session_offered ? "retomada oferecida" : "completa");
+    tls_session_offered = false; // Handshake concluído -> erros seguintes não invalidam a sessão
+#if TLS_BENCHMARK_ROUNDS > 0
+    if (bench_measuring && kind == REQUEST_WEATHER) {
+        size_t used, blocks;
+        mbedtls_memory_buffer_alloc_max_get(&used, &blocks);
+        bench_measuring = false;
+        bench_count[bench_resumed]++;
+        bench_total_us[bench_resumed] += handshake_us;
+        bench_peak[bench_resumed] = used > bench_peak[bench_resumed] ? used : bench_peak[bench_resumed];
+    }
+#endif
+#else
+    printf("Conexao TCP em %lld ms\n", handshake_us / 1000);
+#endif
+    printf("Conectado ao servidor! Enviando requisição HTTP...\n");
+    display_screens(4);
+    altcp_sent(tpcb, http_sent_callback);
+    if (kind == REQUEST_FORECAST) {
+        if (compression_enabled) {
+            altcp_write(tpcb, FORECAST_REQUEST, sizeof(FORECAST_REQUEST) - 1, TCP_WRITE_FLAG_COPY);
+        } else {
+            altcp_write(tpcb, FORECAST_REQUEST_IDENTITY, sizeof(FORECAST_REQUEST_IDENTITY) - 1, TCP_WRITE_FLAG_COPY);
+        }
+    } else if (compression_enabled) {
+        altcp_write(tpcb, REQUEST, sizeof(REQUEST) - 1, TCP_WRITE_FLAG_COPY);
+    } else {
+        altcp_write(tpcb, REQUEST_IDENTITY, sizeof(REQUEST_IDENTITY) - 1, TCP_WRITE_FLAG_COPY);
+    }
+    altcp_output(tpcb);
+}
+
+// Função do gancho received: decodifica a resposta HTTP (p == NULL -> resposta finalizada)
+static bool request_received(struct altcp_pcb *tpcb, request_kind_t kind, struct pbuf *p) {
     display_screens(5);
     if (p != NULL) {
-        // Certifica de não ultrapassar o tamanho do buffer
-        if (response_index + p->len < BUFFER_SIZE - 1) {
-            memcpy(response_buffer + response_index, p->payload, p->len);
-            response_index += p->len;
-            response_buffer[response_index] = '\0';  // Finaliza a string
+        // Decodifica direto do payload de cada pbuf da cadeia, sem cópia intermediária
+        http_body_status_t status = HTTP_BODY_OK;
+        uint32_t start = time_us_32();
+        for (struct pbuf *q = p; q != NULL && status != HTTP_BODY_ERROR; q = q->next) {
+            status = http_body_feed(&response_body, q->payload, q->len);
         }
-        pbuf_free(p);
-    } else {
-        // Resposta finalizada, mostra no terminal para verificação
-        printf("Resposta HTTP armazenada:\n%s\n", response_buffer);
-        display_screens(6);
+        decode_time_us += time_us_32() - start;
+        if (status == HTTP_BODY_ERROR) {
+            printf("Falha ao decodificar a resposta%s\n", compression_enabled ? ", repetindo sem compressao" : "");
+            return false;
+        }
+        return true;
+    }
+
+    // Resposta finalizada, mostra no terminal para verificação
+    const http_request_stats_t *stats = http_request_stats();
+    printf("Resposta HTTP armazenada:\n%s\n", response_buffer_text());
+    printf("Bytes recebidos: %lu, decodificados: %lu, %lu us decodificando (%lu ciclos/byte)\n",
+           response_body.wire_bytes, response_body.body_bytes, decode_time_us,
+           response_body.wire_bytes ? decode_time_us * (clock_get_hz(clk_sys) / 1000000) / response_body.wire_bytes : 0);
+    display_screens(6);
+    if (response_body.status / 100 != 2) {
+        // Erro da API (chave inválida, limite de requisições...): o corpo não tem dados do clima
+        printf("Resposta HTTP %u, dados ignorados\n", response_body.status);
+    } else if (kind == REQUEST_WEATHER) {
         extract_data_from_response();
-        tcp_close(tpcb);
+    } else if (forecast_commit()) {
+        printf("Previsao: %u pontos\n", forecast_count());
+    } else {
+        printf("Previsao incompleta, mantendo a anterior (%u pontos)\n", forecast_count());
     }
-    return ERR_OK;  // ERR_OK indica que a função foi executada com sucesso
+    printf("Requisicoes: %lu (agrupadas: %lu, expiradas: %lu, falhas: %lu), atualizacoes locais pela previsao: %lu\n",
+           stats->made, stats->coalesced, stats->timed_out, stats->failed, local_updates);
+    printf("I2C: %lu Hz, erros: %lu, repeticoes: %lu\n", ssd.baudrate, ssd.i2c_errors, ssd.i2c_retries);
+    mem_report_print();
+#if USE_TLS
+    tls_session_save(tpcb); // Guarda a sessão antes de fechar a conexão
+#endif
+    return true;
 }
 
 // Função de callback para enviar a requisição HTTP
-static err_t http_sent_callback(void *arg, struct tcp_pcb *tpcb, u16_t len) {
+static err_t http_sent_callback(void *arg, struct altcp_pcb *tpcb, u16_t len) {
     printf("Dados enviados com sucesso. Aguardando resposta...\n");
-    tcp_recv(tpcb, http_response_callback); // Aguarda a resposta do servidor
-    return ERR_OK;
-}
-
-// Função de callback para conexão com o servidor
-static err_t http_connected_callback(void *arg, struct tcp_pcb *tpcb, err_t err) {
-    if (err == ERR_OK) {
-        printf("Conectado ao servidor! Enviando requisição HTTP...\n");
-        display_screens(4);
-        tcp_write(tpcb, REQUEST, sizeof(REQUEST) - 1, TCP_WRITE_FLAG_COPY);
-        tcp_output(tpcb);
-        tcp_sent(tpcb, http_sent_callback); // 
-    } else {
-        printf("Erro na conexão: %d\n", err);
-        tcp_close(tpcb);
-    }
     return ERR_OK;
 }
 
-// Função para inicializar a requisição HTTP
-void http_request_init() {
-    struct tcp_pcb *pcb = tcp_new(); 
-    if (pcb == NULL) {
-        printf("Falha ao criar PCB TCP\n");
-        return;
-    }
-    ip4_addr_t server_ip;
-    if (!ip4addr_aton(SERVER_IP, &server_ip)) { // Converte o endereço IP para o formato correto
-        printf("Erro ao converter endereço IP\n");
-        return;
+// Função do gancho finished: conexão já liberada, decide o que vem a seguir
+static void request_finished(request_kind_t kind, request_result_t result) {
+    switch (result) {
+        case REQUEST_DONE:
+            // Com a observação em mãos, busca a previsão se ela ainda não cobre as próximas horas
+            if (kind == REQUEST_WEATHER && epoch_valid &&
+                forecast_needs_refresh(epoch_offset + to_ms_since_boot(get_absolute_time()) / 1000)) {
+                http_request_start(REQUEST_FORECAST);
+            }
+            break;
+        case REQUEST_ABORTED:
+            // Resposta que não decodifica (ex.: referência fora da janela do inflate) -> repete sem compressão
+            if (compression_enabled) {
+                compression_enabled = false;
+                http_request_start(kind);
+            }
+            break;
+        case REQUEST_FAILED:
+            printf("Conexao encerrada com erro: %d\n", http_request_stats()->last_error);
+#if USE_TLS
+            // Uma falha logo após oferecer a sessão pode ser recusa da retomada: o próximo handshake é completo
+            if (tls_session_offered) {
+                tls_session_discard();
+            }
+#endif
+            break;
+        default:
+            printf("Requisicao expirou (%s)\n", result == REQUEST_TIMEOUT_CONNECT ? "conexao" :
+                   result == REQUEST_TIMEOUT_FIRST_BYTE ? "primeiro byte" : "total");
+            display_screens(-2); // "ERRO SEM RESPOSTA"; o laço principal volta à tela do clima
+            break;
     }
-    tcp_connect(pcb, &server_ip, SERVER_PORT, http_connected_callback); // Conecta ao servidor
 }
 
 // Função de manipulação de string para extrair os dados da resposta
 void extract_data_from_response() {
+    const char *response_buffer = response_buffer_text(); // Corpo da observação (inc/response_buffer.c)
     char *description_start, *description_end;
     char *temp_start, *temp_end;
     char *feels_like_start, *feels_like_end;
@@ -325,6 +633,8 @@ void extract_data_from_response() {
             size_t length = temp_end - temp_start;
             strncpy(temperature, temp_start, length);   ;// Copia a temperatura para a variável
             temperature[length] = '\0';
+            api_temperature_centi = (int32_t)(atof(temperature) * 100); // Guarda em centésimos para comparar com o sensor local
+            api_temperature_valid = true;
             strcat(temperature, "_C");  // Adiciona o símbolo de graus Celsius(usei _ como simbolo especial para referenciar o º)
         }
     }
@@ -338,32 +648,128 @@ void extract_data_from_response() {
             size_t length = feels_like_end - feels_like_start;
             strncpy(feels_like, feels_like_start, length);  // Copia a sensação térmica para a variável
             feels_like[length] = '\0';
+            api_feels_like_centi = (int32_t)(atof(feels_like) * 100);
             strcat(feels_like, "_C");   // Adiciona o símbolo de graus Celsius(usei _ como simbolo especial para referenciar o º)
         }
     }
+
+    // Extrai "dt" (horário Unix da observação) -> relógio local e correção da previsão
+    char *dt_start = strstr(response_buffer, "\"dt\":");
+    if (dt_start && api_temperature_valid) {
+        uint32_t dt = strtoul(dt_start + strlen("\"dt\":"), NULL, 10);
+        epoch_offset = dt - to_ms_since_boot(get_absolute_time()) / 1000;
+        epoch_valid = true;
+        forecast_observe(dt, api_temperature_centi, api_feels_like_centi);
+    }
+
+    display_dirty = true; // O laço principal redesenha a tela com os novos valores
 }
 
-// Função para evitar o boucing dos botões
-bool debounce(){
-    uint current_time = to_ms_since_boot(get_absolute_time());
-    if(current_time - last_time > 200){
-        last_time = current_time;
-        return true;
+// Função para tratar os eventos dos botões (contexto principal, fora de IRQ)
+void handle_input(const input_event_t *event){
+    if(event->type != INPUT_PRESS && event->type != INPUT_REPEAT){
+        return;
+    }
+    if(event->gpio == BUTTON_A){
+        screen = screen >= 7 && screen < 10 ? screen + 1 : screen; // Alterna entre as telas
+    }
+    if(event->gpio == BUTTON_B){
+        screen = screen > 7 && screen <= 10 ? screen - 1 : screen; // Alterna entre as telas
+    }
+    if(event->gpio == JYSTCK_BTTN && event->type == INPUT_PRESS){
+        cyw43_arch_lwip_begin(); // Entrada no lwIP fora do callback exige o lock do cyw43_arch
+        http_request_start(REQUEST_WEATHER); // Requisita os dados novamente ao pressionar o botão do joystick
+        cyw43_arch_lwip_end();
     }
-    return false;
 }
 
-// Função IRQ de callback para tratar os botões
-void buttons_handler(uint gpio, uint32_t events){
-    if(debounce()){
-        if(gpio == BUTTON_A){
-            screen = screen == 7 ? 8 : screen == 8 ? 9 : screen; // Alterna entre as telas
+// Função auxiliar para formatar centésimos de grau como "27.5_C"
+void format_centi(char *out, size_t size, int32_t centi){
+    int32_t magnitude = centi < 0 ? -centi : centi;
+    snprintf(out, size, "%s%ld.%ld_C", centi < 0 ? "-" : "", magnitude / 100, (magnitude % 100) / 10);
+}
+
+// Função para atualizar a temperatura local e comparar com a da API
+void update_local_temperature(){
+    int32_t centi;
+    if(!temp_sensor_read(&centi)){
+        return;
+    }
+    char text[10];
+    format_centi(text, sizeof(text), centi);
+
+    bool disagrees = api_temperature_valid &&
+                     (centi - api_temperature_centi > TEMP_DISAGREE_CENTI ||
+                      api_temperature_centi - centi > TEMP_DISAGREE_CENTI);
+
+    if(strcmp(text, local_temperature) != 0 || disagrees != temperature_disagrees){
+        strcpy(local_temperature, text);
+        temperature_disagrees = disagrees;
+        if(screen == 10){
+            display_dirty = true;
         }
-        if(gpio == BUTTON_B){
-            screen = screen == 9 ? 8 : screen == 8 ? 7 : screen; // Alterna entre as telas
+    }
+}
+
+// Função para atualizar temperatura e sensação térmica pela previsão, sem acessar a rede
+void update_interpolated_weather(){
+    if(!epoch_valid){
+        return;
+    }
+    uint32_t now = epoch_offset + to_ms_since_boot(get_absolute_time()) / 1000;
+
+    int32_t temp_centi, feels_centi;
+    if(forecast_estimate(now, &temp_centi, &feels_centi)){
+        char temp_text[10], feels_text[10];
+        format_centi(temp_text, sizeof(temp_text), temp_centi);
+        format_centi(feels_text, sizeof(feels_text), feels_centi);
+        if(strcmp(temp_text, temperature) != 0 || strcmp(feels_text, feels_like) != 0){
+            strcpy(temperature, temp_text);
+            strcpy(feels_like, feels_text);
+            local_updates++;
+            if(screen == 7 || screen == 8){
+                display_dirty = true;
+            }
         }
-        if(gpio == JYSTCK_BTTN){
-            http_request_init();    // Requisita os dados novamente ao pressionar o botão do joystick
+    }
+
+    // Previsão acabando (ou ausente) -> busca uma nova, sem insistir se o servidor falhar
+    static absolute_time_t last_forecast_attempt;
+    if(forecast_needs_refresh(now) && !http_request_busy() &&
+       absolute_time_diff_us(last_forecast_attempt, get_absolute_time()) >= FORECAST_RETRY_MS * 1000ll){
+        last_forecast_attempt = get_absolute_time();
+        cyw43_arch_lwip_begin();
+        http_request_start(REQUEST_FORECAST);
+        cyw43_arch_lwip_end();
+    }
+}
+
+#if USE_TLS && TLS_BENCHMARK_ROUNDS > 0
+// Função do benchmark (laço principal): com a rede livre, dispara o próximo handshake e,
+// depois do último, mostra a média e o pico da arena de cada tipo
+void tls_benchmark_step(){
+    static bool reported = false;
+    if(http_request_busy() || reported){
+        return;
+    }
+    if(bench_started < 2 * TLS_BENCHMARK_ROUNDS){
+        cyw43_arch_lwip_begin();
+        bench_resumed = bench_started % 2 == 1 && tls_session_valid;
+        if(!bench_resumed){
+            tls_session_discard(); // Força o handshake completo
         }
+        bench_started++;
+        bench_measuring = true;
+        mbedtls_memory_buffer_alloc_max_reset(); // Pico medido só a partir deste handshake
+        http_request_start(REQUEST_WEATHER);
+        cyw43_arch_lwip_end();
+        return;
     }
-}
\ No newline at end of file
+    reported = true;
+    for(int k = 0; k < 2; k++){
+        printf("Benchmark TLS %s: %lu handshakes, media %lld ms, pico da arena %u bytes\n",
+               k ? "retomado" : "completo", bench_count[k],
+               bench_count[k] ? bench_total_us[k] / bench_count[k] / 1000 : 0, (unsigned)bench_peak[k]);
+    }
+}
+#endif
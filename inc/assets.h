@@ -1,13 +1,43 @@
+#ifndef ASSETS_H
+#define ASSETS_H
+
 #define API_KEY "SUA_API_KEY"
 #define CIDADE "SUA_CIDADE,SEU_PAIS"
 #define API_URL "/data/2.5/weather?q="CIDADE"&appid="API_KEY"&units=metric&lang=pt_br"
+#define FORECAST_URL "/data/2.5/forecast?q="CIDADE"&appid="API_KEY"&units=metric&cnt=8"
 #define URL "api.openweathermap.org"
 
 #define SERVER_IP "38.89.70.155"
-#define REQUEST "GET "API_URL" HTTP/1.1\r\n" \
-                "Host: api.openweathermap.org\r\n" \
-                "Connection: close\r\n\r\n"
+#define REQUEST_HEAD "GET "API_URL" HTTP/1.1\r\n" \
+                     "Host: api.openweathermap.org\r\n" \
+                     "Connection: close\r\n"
+#define REQUEST REQUEST_HEAD "Accept-Encoding: gzip, deflate\r\n\r\n"
+#define REQUEST_IDENTITY REQUEST_HEAD "\r\n"  // Usada se a resposta comprimida não puder ser decodificada
+
+// Previsão de 3 em 3 horas (8 pontos = 24 h), buscada uma vez e interpolada localmente
+#define FORECAST_REQUEST_HEAD "GET "FORECAST_URL" HTTP/1.1\r\n" \
+                              "Host: api.openweathermap.org\r\n" \
+                              "Connection: close\r\n"
+#define FORECAST_REQUEST FORECAST_REQUEST_HEAD "Accept-Encoding: gzip, deflate\r\n\r\n"
+#define FORECAST_REQUEST_IDENTITY FORECAST_REQUEST_HEAD "\r\n"
+
+// 1 -> HTTPS (porta 443, mbedTLS com retomada de sessão); 0 -> HTTP puro na porta 80
+#define USE_TLS 1
+#if USE_TLS
+#define SERVER_PORT 443
+#else
 #define SERVER_PORT 80
+#endif
+
+// Benchmark do handshake TLS: N handshakes completos e N retomados logo após conectar ao WiFi,
+// com tempo médio e pico da arena do mbedTLS de cada tipo. 0 desliga; o build com o servidor
+// local (tools/tls_standin.sh) liga automaticamente.
+#ifndef TLS_BENCHMARK_ROUNDS
+#define TLS_BENCHMARK_ROUNDS 0
+#endif
+
+#define WIFI_SSID "SEU_SSID" // Também aparece nas telas de status geradas na compilação
+static char* SSID = WIFI_SSID;
+static char* PASSWORD = "SUA_SENHA";
 
-static char* SSID = "SEU_SSID";
-static char* PASSWORD = "SUA_SENHA";
\ No newline at end of file
+#endif
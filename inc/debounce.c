@@ -0,0 +1,34 @@
+#include "debounce.h"
+
+void debounce_init(debounce_t *pin, uint8_t gpio, bool pressed) {
+    *pin = (debounce_t){.gpio = gpio, .pressed = pressed};
+}
+
+// Função para registrar uma borda (vinda da fila da IRQ)
+void debounce_edge(debounce_t *pin, uint64_t time_us) {
+    pin->last_edge_us = time_us;
+}
+
+// Função chamada a cada tick com o nível atual: o nível só é aceito depois de
+// INPUT_DEBOUNCE_US sem bordas; pressionado, gera long-press e depois repetições
+void debounce_tick(debounce_t *pin, bool pressed, uint64_t now_us, debounce_emit_t emit) {
+    if (now_us - pin->last_edge_us >= INPUT_DEBOUNCE_US && pressed != pin->pressed) {
+        pin->pressed = pressed;
+        if (pressed) {
+            pin->press_us = pin->last_edge_us;
+            pin->long_sent = false;
+        }
+        emit(pin->gpio, pressed ? INPUT_PRESS : INPUT_RELEASE, (uint32_t)(pin->last_edge_us / 1000));
+    }
+    if (!pin->pressed) {
+        return;
+    }
+    if (!pin->long_sent && now_us - pin->press_us >= INPUT_LONG_PRESS_MS * 1000ull) {
+        pin->long_sent = true;
+        pin->next_repeat_us = now_us + INPUT_REPEAT_MS * 1000ull;
+        emit(pin->gpio, INPUT_LONG_PRESS, (uint32_t)(now_us / 1000));
+    } else if (pin->long_sent && now_us >= pin->next_repeat_us) {
+        pin->next_repeat_us += INPUT_REPEAT_MS * 1000ull;
+        emit(pin->gpio, INPUT_REPEAT, (uint32_t)(now_us / 1000));
+    }
+}
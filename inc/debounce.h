@@ -0,0 +1,27 @@
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "input.h"
+
+// Máquina de estados de debounce de um botão, sem acesso ao hardware: recebe o instante de
+// cada borda e, a cada tick, o nível atual do pino, e gera os eventos tipados.
+// Os tempos são em µs de 64 bits (time_us_64 no firmware), então nenhuma conta dá a volta.
+
+typedef void (*debounce_emit_t)(uint8_t gpio, input_event_type_t type, uint32_t time_ms);
+
+typedef struct {
+    uint8_t gpio;
+    bool pressed;           // Último nível estável
+    bool long_sent;
+    uint64_t last_edge_us;
+    uint64_t press_us;
+    uint64_t next_repeat_us;
+} debounce_t;
+
+void debounce_init(debounce_t *pin, uint8_t gpio, bool pressed);
+void debounce_edge(debounce_t *pin, uint64_t time_us);
+void debounce_tick(debounce_t *pin, bool pressed, uint64_t now_us, debounce_emit_t emit);
+
+#endif
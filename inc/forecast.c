@@ -0,0 +1,235 @@
+#include <string.h>
+#include "forecast.h"
+
+// Campos extraídos de cada item da lista
+enum {
+    FIELD_NONE,
+    FIELD_DT,
+    FIELD_TEMP,
+    FIELD_FEELS_LIKE,
+    FIELD_CNT           // Número de itens anunciado pela API, antes da lista
+};
+
+// Estado do extrator: percorre o JSON byte a byte sem guardar a resposta inteira
+typedef struct {
+    bool in_string, escape, key_ready;
+    char key[12];
+    uint8_t key_len;
+
+    uint8_t field;          // Campo cujo valor numérico está sendo lido
+    bool in_number, negative, digits;
+    uint32_t whole;
+    uint8_t frac_digits;
+    int32_t frac;
+
+    forecast_point_t point; // Item em montagem
+    uint8_t point_fields;
+    uint32_t cnt;
+} scanner_t;
+
+static scanner_t scanner;
+
+// Previsão em uso; a resposta em andamento vai para 'staging' e só a substitui em forecast_commit
+static forecast_point_t points[FORECAST_MAX_POINTS];
+static uint8_t count = 0;
+static forecast_point_t staging[FORECAST_MAX_POINTS];
+static uint8_t staging_count = 0;
+
+// Última observação e a correção calculada a partir dela
+static bool observed = false, offset_valid = false;
+static uint32_t observed_dt;
+static int32_t observed_temp, observed_feels;
+static int32_t temp_offset, feels_offset;
+
+static bool interpolate(uint32_t now, int32_t *temp, int32_t *feels);
+
+void forecast_begin(void) {
+    memset(&scanner, 0, sizeof(scanner));
+    staging_count = 0;
+}
+
+uint8_t forecast_count(void) {
+    return count;
+}
+
+// Recalcula a correção com a previsão em uso (a observação pode ter chegado antes dela)
+static void update_offset(void) {
+    int32_t temp, feels;
+    offset_valid = observed && interpolate(observed_dt, &temp, &feels);
+    if (offset_valid) {
+        temp_offset = observed_temp - temp;
+        feels_offset = observed_feels - feels;
+    }
+}
+
+bool forecast_commit(void) {
+    uint8_t expected = scanner.cnt < FORECAST_MAX_POINTS ? scanner.cnt : FORECAST_MAX_POINTS;
+    if (staging_count < 2 || staging_count != expected) {
+        return false;   // Resposta cortada ou sem a lista: mantém a previsão anterior
+    }
+    memcpy(points, staging, sizeof(points));
+    count = staging_count;
+    update_offset();
+    return true;
+}
+
+static void commit_point(void) {
+    if (scanner.point_fields == ((1 << FIELD_DT) | (1 << FIELD_TEMP) | (1 << FIELD_FEELS_LIKE)) &&
+        staging_count < FORECAST_MAX_POINTS) {
+        staging[staging_count++] = scanner.point;
+    }
+    scanner.point_fields = 0;
+}
+
+static void finish_number(void) {
+    int32_t centi = scanner.whole * 100 + scanner.frac * (scanner.frac_digits == 1 ? 10 : 1);
+    if (scanner.negative) {
+        centi = -centi;
+    }
+    switch (scanner.field) {
+        case FIELD_DT:
+            commit_point(); // "dt" abre um novo item da lista
+            scanner.point.dt = scanner.whole;
+            break;
+        case FIELD_TEMP:
+            scanner.point.temp = centi;
+            break;
+        case FIELD_FEELS_LIKE:
+            scanner.point.feels_like = centi;
+            break;
+        case FIELD_CNT:
+            scanner.cnt = scanner.whole;
+            break;
+    }
+    if (scanner.field != FIELD_CNT) {
+        scanner.point_fields |= 1 << scanner.field;
+    }
+    scanner.in_number = false;
+    scanner.field = FIELD_NONE;
+}
+
+static uint8_t match_key(void) {
+    scanner.key[scanner.key_len] = '\0';
+    if (strcmp(scanner.key, "dt") == 0) return FIELD_DT;
+    if (strcmp(scanner.key, "temp") == 0) return FIELD_TEMP;
+    if (strcmp(scanner.key, "feels_like") == 0) return FIELD_FEELS_LIKE;
+    if (strcmp(scanner.key, "cnt") == 0) return FIELD_CNT;
+    return FIELD_NONE;
+}
+
+void forecast_sink(void *ctx, const uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        char c = data[i];
+
+        if (scanner.in_number) {
+            if (!scanner.digits && (c == ' ' || c == '-')) {
+                scanner.negative |= c == '-';
+                continue;
+            }
+            if (c >= '0' && c <= '9') {
+                scanner.digits = true;
+                if (scanner.frac_digits == 0xFF) {
+                    scanner.whole = scanner.whole * 10 + (c - '0');
+                } else if (scanner.frac_digits < 2) {
+                    scanner.frac = scanner.frac * 10 + (c - '0');
+                    scanner.frac_digits++;
+                }
+                continue;
+            }
+            if (c == '.') {
+                scanner.frac_digits = 0;
+                continue;
+            }
+            finish_number();
+        }
+
+        if (scanner.in_string) {
+            if (scanner.escape) {
+                scanner.escape = false;
+            } else if (c == '\\') {
+                scanner.escape = true;
+            } else if (c == '"') {
+                scanner.in_string = false;
+                scanner.key_ready = true;
+            } else if (scanner.key_len < sizeof(scanner.key) - 1) {
+                scanner.key[scanner.key_len++] = c;
+            }
+            continue;
+        }
+
+        if (c == '"') {
+            scanner.in_string = true;
+            scanner.key_len = 0;
+        } else if (c == ':' && scanner.key_ready) {
+            scanner.key_ready = false;
+            scanner.field = match_key();
+            if (scanner.field != FIELD_NONE) {
+                scanner.in_number = true;
+                scanner.negative = false;
+                scanner.digits = false;
+                scanner.whole = 0;
+                scanner.frac = 0;
+                scanner.frac_digits = 0xFF; // Ainda na parte inteira
+            }
+        } else if (c == ']') {
+            commit_point(); // Fim da lista -> fecha o último item
+        } else if (c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+            scanner.key_ready = false;
+        }
+    }
+}
+
+// Interpolação linear em Q16 entre os pontos que cercam 'now'. Até um intervalo antes do
+// primeiro ponto (a observação costuma ser de minutos antes dele) o primeiro ponto é mantido.
+static bool interpolate(uint32_t now, int32_t *temp, int32_t *feels) {
+    if (count < 2) {
+        return false;
+    }
+    if (now < points[0].dt) {
+        if (points[0].dt - now > points[1].dt - points[0].dt) {
+            return false;
+        }
+        *temp = points[0].temp;
+        *feels = points[0].feels_like;
+        return true;
+    }
+    for (uint8_t i = 0; i + 1 < count; i++) {
+        if (now <= points[i + 1].dt) {
+            uint32_t span = points[i + 1].dt - points[i].dt;
+            int32_t frac = (int32_t)(((uint64_t)(now - points[i].dt) << 16) / span);
+            *temp = points[i].temp + (((int32_t)(points[i + 1].temp - points[i].temp) * frac) >> 16);
+            *feels = points[i].feels_like + (((int32_t)(points[i + 1].feels_like - points[i].feels_like) * frac) >> 16);
+            return true;
+        }
+    }
+    return false;
+}
+
+void forecast_observe(uint32_t dt, int32_t temp_centi, int32_t feels_centi) {
+    observed = true;
+    observed_dt = dt;
+    observed_temp = temp_centi;
+    observed_feels = feels_centi;
+    update_offset();
+}
+
+bool forecast_estimate(uint32_t now, int32_t *temp_centi, int32_t *feels_centi) {
+    if (!interpolate(now, temp_centi, feels_centi)) {
+        return false;
+    }
+    // A correção da observação cai linearmente até zero em FORECAST_BLEND_S
+    if (offset_valid && now >= observed_dt && now - observed_dt < FORECAST_BLEND_S) {
+        int32_t weight = FORECAST_BLEND_S - (now - observed_dt);
+        *temp_centi += (int32_t)((int64_t)temp_offset * weight / FORECAST_BLEND_S);
+        *feels_centi += (int32_t)((int64_t)feels_offset * weight / FORECAST_BLEND_S);
+    }
+    return true;
+}
+
+bool forecast_needs_refresh(uint32_t now) {
+    if (count < 2) {
+        return true;
+    }
+    uint32_t step = points[count - 1].dt - points[count - 2].dt;
+    return now + step >= points[count - 1].dt;
+}
@@ -0,0 +1,40 @@
+#ifndef FORECAST_H
+#define FORECAST_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Previsão de 3 em 3 horas guardada em forma compacta. Entre as requisições, a temperatura
+// e a sensação térmica exibidas são interpoladas (ponto fixo) entre os pontos da previsão,
+// corrigidas pela diferença para a última observação, que decai até sumir.
+
+#define FORECAST_MAX_POINTS 8           // 8 pontos de 3 h = 24 h (parâmetro cnt da API)
+#define FORECAST_BLEND_S (3 * 3600)     // Tempo até a correção da observação zerar
+
+typedef struct {
+    uint32_t dt;            // Horário Unix do ponto
+    int16_t temp;           // Centésimos de grau
+    int16_t feels_like;     // Centésimos de grau
+} forecast_point_t;
+
+// Recebe o corpo da resposta da previsão em pedaços (sink do http_body) numa área separada;
+// forecast_commit a coloca em uso se a lista veio inteira (quantos itens o "cnt" anunciou).
+// Se a resposta falhar ou vier cortada, a previsão anterior continua valendo.
+void forecast_begin(void);
+void forecast_sink(void *ctx, const uint8_t *data, size_t len);
+bool forecast_commit(void);
+uint8_t forecast_count(void);
+
+// Registra uma observação (resposta do /weather) para a correção; a correção é recalculada
+// quando uma nova previsão entra em uso, então a ordem das duas respostas não importa
+void forecast_observe(uint32_t dt, int32_t temp_centi, int32_t feels_centi);
+
+// Estima os valores no instante 'now'; false se a previsão não cobre o instante.
+// Até um intervalo antes do primeiro ponto vale o primeiro ponto (mais a correção).
+bool forecast_estimate(uint32_t now, int32_t *temp_centi, int32_t *feels_centi);
+
+// true se a previsão está vazia ou termina em menos de um intervalo
+bool forecast_needs_refresh(uint32_t now);
+
+#endif
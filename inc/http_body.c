@@ -0,0 +1,314 @@
+#include <string.h>
+#include <strings.h>
+#include <stdlib.h>
+#include "http_body.h"
+
+// Estados do corpo da resposta
+enum {
+    BODY_HEADERS,
+    BODY_CHUNK_SIZE,
+    BODY_CHUNK_DATA,
+    BODY_CHUNK_END,
+    BODY_TRAILER,
+    BODY_CONTENT,
+    BODY_DONE,
+    BODY_ERROR
+};
+
+// Estados do cabeçalho gzip (RFC 1952) / zlib (RFC 1950)
+enum {
+    WRAP_GZIP_FIXED,
+    WRAP_GZIP_XLEN,
+    WRAP_GZIP_EXTRA,
+    WRAP_GZIP_NAME,
+    WRAP_GZIP_COMMENT,
+    WRAP_GZIP_HCRC,
+    WRAP_ZLIB,
+    WRAP_DATA,
+    WRAP_DONE
+};
+
+#define GZIP_FHCRC 0x02
+#define GZIP_FEXTRA 0x04
+#define GZIP_FNAME 0x08
+#define GZIP_FCOMMENT 0x10
+
+// Repassa a saída do inflater contabilizando os bytes decodificados
+static void inflate_to_sink(void *ctx, const uint8_t *data, size_t len) {
+    http_body_t *body = (http_body_t *)ctx;
+    body->body_bytes += len;
+    body->sink(body->ctx, data, len);
+}
+
+void http_body_init(http_body_t *body, http_body_sink_t sink, void *ctx) {
+    memset(body, 0, sizeof(*body));
+    body->state = BODY_HEADERS;
+    body->status_line = true;
+    body->sink = sink;
+    body->ctx = ctx;
+}
+
+// Compara o nome do cabeçalho (sem diferenciar maiúsculas) e aponta para o valor
+static bool header_is(const char *line, const char *name, const char **value) {
+    size_t n = strlen(name);
+    if (strncasecmp(line, name, n) != 0 || line[n] != ':') {
+        return false;
+    }
+    *value = line + n + 1;
+    while (**value == ' ' || **value == '\t') {
+        (*value)++;
+    }
+    return true;
+}
+
+// Procura um token no valor do cabeçalho, sem diferenciar maiúsculas
+static bool value_has(const char *value, const char *token) {
+    size_t n = strlen(token);
+    for (; *value; value++) {
+        if (strncasecmp(value, token, n) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void parse_header_line(http_body_t *body) {
+    const char *value;
+    body->line[body->line_len] = '\0';
+    if (body->status_line) {
+        body->status_line = false;
+        if (strncmp(body->line, "HTTP/", 5) == 0 && body->line_len > 9) {
+            body->status = atoi(body->line + 9);
+        }
+    } else if (header_is(body->line, "Transfer-Encoding", &value)) {
+        body->chunked = value_has(value, "chunked");
+    } else if (header_is(body->line, "Content-Encoding", &value)) {
+        if (value_has(value, "gzip")) {
+            body->encoding = HTTP_ENCODING_GZIP;
+        } else if (value_has(value, "deflate")) {
+            body->encoding = HTTP_ENCODING_DEFLATE;
+        }
+    }
+}
+
+// Escolhe o próximo campo opcional do cabeçalho gzip conforme as flags restantes
+static void gzip_next_field(http_body_t *body) {
+    body->wrap_count = 0;
+    if (body->wrap_flags & GZIP_FEXTRA) {
+        body->wrap_flags &= ~GZIP_FEXTRA;
+        body->wrap_state = WRAP_GZIP_XLEN;
+    } else if (body->wrap_flags & GZIP_FNAME) {
+        body->wrap_flags &= ~GZIP_FNAME;
+        body->wrap_state = WRAP_GZIP_NAME;
+    } else if (body->wrap_flags & GZIP_FCOMMENT) {
+        body->wrap_flags &= ~GZIP_FCOMMENT;
+        body->wrap_state = WRAP_GZIP_COMMENT;
+    } else if (body->wrap_flags & GZIP_FHCRC) {
+        body->wrap_flags &= ~GZIP_FHCRC;
+        body->wrap_state = WRAP_GZIP_HCRC;
+    } else {
+        body->wrap_state = WRAP_DATA;
+    }
+}
+
+// Consome um byte do cabeçalho gzip/zlib; retorna false se o cabeçalho for inválido
+static bool wrapper_byte(http_body_t *body, uint8_t byte) {
+    switch (body->wrap_state) {
+        case WRAP_GZIP_FIXED:
+            if ((body->wrap_count == 0 && byte != 0x1F) ||
+                (body->wrap_count == 1 && byte != 0x8B) ||
+                (body->wrap_count == 2 && byte != 8)) {
+                return false;
+            }
+            if (body->wrap_count == 3) {
+                body->wrap_flags = byte;
+            }
+            if (++body->wrap_count == 10) {
+                gzip_next_field(body);
+            }
+            return true;
+        case WRAP_GZIP_XLEN:
+            body->wrap_skip |= (uint16_t)byte << (8 * body->wrap_count);
+            if (++body->wrap_count == 2) {
+                body->wrap_state = WRAP_GZIP_EXTRA;
+                if (body->wrap_skip == 0) {
+                    gzip_next_field(body);
+                }
+            }
+            return true;
+        case WRAP_GZIP_EXTRA:
+            if (--body->wrap_skip == 0) {
+                gzip_next_field(body);
+            }
+            return true;
+        case WRAP_GZIP_NAME:
+        case WRAP_GZIP_COMMENT:
+            if (byte == 0) {
+                gzip_next_field(body);
+            }
+            return true;
+        case WRAP_GZIP_HCRC:
+            if (++body->wrap_count == 2) {
+                gzip_next_field(body);
+            }
+            return true;
+        case WRAP_ZLIB:
+            if (body->wrap_count == 0) {
+                body->wrap_flags = byte;    // CMF
+            } else {
+                if (((body->wrap_flags << 8) | byte) % 31 != 0 || (byte & 0x20)) {
+                    return false;   // Checagem inválida ou dicionário predefinido
+                }
+                body->wrap_state = WRAP_DATA;
+            }
+            body->wrap_count++;
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Entrega bytes do corpo (já sem chunks) ao decodificador de conteúdo
+static http_body_status_t content(http_body_t *body, const uint8_t *data, size_t len) {
+    if (body->encoding == HTTP_ENCODING_IDENTITY) {
+        body->body_bytes += len;
+        body->sink(body->ctx, data, len);
+        return HTTP_BODY_OK;
+    }
+
+    size_t i = 0;
+    while (i < len && body->wrap_state != WRAP_DATA && body->wrap_state != WRAP_DONE) {
+        // Alguns servidores mandam "deflate" sem o envelope zlib: CM != 8 -> DEFLATE puro
+        if (body->wrap_state == WRAP_ZLIB && body->wrap_count == 0 && (data[i] & 0x0F) != 8) {
+            body->wrap_state = WRAP_DATA;
+            break;
+        }
+        if (!wrapper_byte(body, data[i++])) {
+            return HTTP_BODY_ERROR;
+        }
+    }
+    if (body->wrap_state != WRAP_DATA || i == len) {
+        return body->wrap_state == WRAP_DONE ? HTTP_BODY_DONE : HTTP_BODY_OK;
+    }
+
+    // O trailer (CRC32/ISIZE ou Adler-32) é ignorado: a integridade já vem do TCP/TLS
+    switch (inflate_feed(&body->inflater, data + i, len - i)) {
+        case INFLATE_OK:
+            return HTTP_BODY_OK;
+        case INFLATE_DONE:
+            body->wrap_state = WRAP_DONE;
+            return HTTP_BODY_DONE;
+        default:
+            return HTTP_BODY_ERROR;
+    }
+}
+
+static int hex_digit(uint8_t c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Função para alimentar o decodificador com um pedaço da resposta (ex.: payload de um pbuf)
+http_body_status_t http_body_feed(http_body_t *body, const uint8_t *data, size_t len) {
+    size_t i = 0;
+    http_body_status_t ret = HTTP_BODY_OK;
+
+    body->wire_bytes += len;
+
+    while (i < len && ret == HTTP_BODY_OK) {
+        uint8_t c = data[i];
+        switch (body->state) {
+            case BODY_HEADERS:
+                i++;
+                if (c == '\r') {
+                    break;
+                }
+                if (c != '\n') {
+                    if (body->line_len < sizeof(body->line) - 1) {
+                        body->line[body->line_len++] = c;
+                    }
+                    break;
+                }
+                if (body->line_len == 0) {
+                    // Linha em branco -> início do corpo
+                    if (body->encoding == HTTP_ENCODING_GZIP) {
+                        body->wrap_state = WRAP_GZIP_FIXED;
+                    } else if (body->encoding == HTTP_ENCODING_DEFLATE) {
+                        body->wrap_state = WRAP_ZLIB;
+                    }
+                    if (body->encoding != HTTP_ENCODING_IDENTITY) {
+                        inflate_init(&body->inflater, inflate_to_sink, body);
+                    }
+                    body->state = body->chunked ? BODY_CHUNK_SIZE : BODY_CONTENT;
+                } else {
+                    parse_header_line(body);
+                    body->line_len = 0;
+                }
+                break;
+
+            case BODY_CHUNK_SIZE:
+                i++;
+                if (c == '\n') {
+                    body->chunk_ext = false;
+                    body->line_len = 0;
+                    body->state = body->chunk_left ? BODY_CHUNK_DATA : BODY_TRAILER;
+                } else if (!body->chunk_ext && hex_digit(c) >= 0) {
+                    body->chunk_left = (body->chunk_left << 4) | hex_digit(c);
+                } else if (c != '\r') {
+                    body->chunk_ext = true;
+                }
+                break;
+
+            case BODY_CHUNK_DATA: {
+                size_t n = len - i < body->chunk_left ? len - i : body->chunk_left;
+                ret = content(body, data + i, n);
+                i += n;
+                body->chunk_left -= n;
+                if (body->chunk_left == 0) {
+                    body->state = BODY_CHUNK_END;
+                }
+                break;
+            }
+
+            case BODY_CHUNK_END:
+                i++;
+                if (c == '\n') {
+                    body->state = BODY_CHUNK_SIZE;
+                }
+                break;
+
+            case BODY_TRAILER:
+                i++;
+                if (c == '\n') {
+                    if (body->line_len == 0) {
+                        body->state = BODY_DONE;
+                        ret = HTTP_BODY_DONE;
+                    }
+                    body->line_len = 0;
+                } else if (c != '\r') {
+                    body->line_len = 1;
+                }
+                break;
+
+            case BODY_CONTENT:
+                ret = content(body, data + i, len - i);
+                i = len;
+                break;
+
+            case BODY_DONE:
+                return HTTP_BODY_DONE;
+
+            default:
+                return HTTP_BODY_ERROR;
+        }
+    }
+
+    if (ret == HTTP_BODY_DONE) {
+        body->state = BODY_DONE;
+    } else if (ret == HTTP_BODY_ERROR) {
+        body->state = BODY_ERROR;
+    }
+    return ret;
+}
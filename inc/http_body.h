@@ -0,0 +1,55 @@
+#ifndef HTTP_BODY_H
+#define HTTP_BODY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "inflate.h"
+
+// Decodificador incremental da resposta HTTP/1.1: separa os cabeçalhos, desfaz o
+// Transfer-Encoding chunked e descomprime Content-Encoding gzip/deflate.
+// O corpo já decodificado é entregue ao sink conforme os pbufs chegam.
+
+typedef void (*http_body_sink_t)(void *ctx, const uint8_t *data, size_t len);
+
+typedef enum {
+    HTTP_BODY_OK,
+    HTTP_BODY_DONE,     // Fim do corpo identificado (último chunk ou fim do fluxo comprimido)
+    HTTP_BODY_ERROR     // Resposta malformada ou fluxo comprimido que não cabe na janela
+} http_body_status_t;
+
+typedef enum {
+    HTTP_ENCODING_IDENTITY,
+    HTTP_ENCODING_GZIP,
+    HTTP_ENCODING_DEFLATE
+} http_encoding_t;
+
+typedef struct {
+    uint8_t state;
+    char line[64];          // Linha de cabeçalho atual (o excesso é descartado)
+    uint8_t line_len;
+    bool status_line;
+    uint16_t status;
+    bool chunked;
+    http_encoding_t encoding;
+    uint32_t chunk_left;
+    bool chunk_ext;         // Extensão do chunk (após ';') até o fim da linha
+
+    // Cabeçalho gzip/zlib antes do fluxo DEFLATE
+    uint8_t wrap_state;
+    uint8_t wrap_flags;
+    uint16_t wrap_count;
+    uint16_t wrap_skip;
+
+    uint32_t wire_bytes;    // Bytes recebidos do servidor (cabeçalhos inclusos)
+    uint32_t body_bytes;    // Bytes entregues ao sink
+
+    http_body_sink_t sink;
+    void *ctx;
+    inflate_t inflater;
+} http_body_t;
+
+void http_body_init(http_body_t *body, http_body_sink_t sink, void *ctx);
+http_body_status_t http_body_feed(http_body_t *body, const uint8_t *data, size_t len);
+
+#endif
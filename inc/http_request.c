@@ -0,0 +1,172 @@
+#include "http_request.h"
+
+// Contexto da requisição em andamento (passado aos callbacks pelo arg do lwIP)
+typedef struct {
+    struct altcp_pcb *pcb;
+    request_kind_t kind;
+    request_phase_t phase;
+    absolute_time_t started;        // Início da conexão -> prazo total
+    absolute_time_t phase_deadline; // Prazo da fase atual
+    bool weather_pending;           // Observação pedida durante a previsão -> feita em seguida
+} http_request_t;
+
+static http_request_t request = {.phase = PHASE_IDLE};
+static http_request_stats_t stats;
+static const http_request_hooks_t *hooks;
+static ip_addr_t server_ip;
+static u16_t server_port;
+
+void http_request_init(const http_request_hooks_t *request_hooks, const ip_addr_t *server, u16_t port) {
+    hooks = request_hooks;
+    server_ip = *server;
+    server_port = port;
+    request = (http_request_t){.phase = PHASE_IDLE};
+    stats = (http_request_stats_t){0};
+}
+
+bool http_request_busy(void) {
+    return request.phase != PHASE_IDLE;
+}
+
+const http_request_stats_t *http_request_stats(void) {
+    return &stats;
+}
+
+// Função para encerrar a requisição atual: solta os callbacks e fecha a conexão
+// (ou aborta, se pedido ou se o fechamento falhar). Retorna ERR_ABRT se abortou.
+static err_t http_request_end(http_request_t *req, bool abort) {
+    struct altcp_pcb *pcb = req->pcb;
+    req->pcb = NULL;
+    req->phase = PHASE_IDLE;
+    if (pcb == NULL) {
+        return ERR_OK;
+    }
+    altcp_arg(pcb, NULL);
+    altcp_recv(pcb, NULL);
+    altcp_sent(pcb, NULL);
+    altcp_err(pcb, NULL);
+    altcp_poll(pcb, NULL, 0);
+    if (!abort && altcp_close(pcb) == ERR_OK) {
+        return ERR_OK;
+    }
+    altcp_abort(pcb);
+    return ERR_ABRT;
+}
+
+// Função para encerrar a requisição, avisar a aplicação e, se ela não iniciou outra,
+// fazer a observação que ficou pendente durante a previsão
+static err_t http_request_finish(http_request_t *req, bool abort, request_result_t result) {
+    request_kind_t kind = req->kind;
+    err_t ret = http_request_end(req, abort);
+    hooks->finished(kind, result);
+    if (req->phase == PHASE_IDLE && req->weather_pending) {
+        req->weather_pending = false;
+        http_request_start(REQUEST_WEATHER);
+    }
+    return ret;
+}
+
+// Função de callback que lida com a resposta HTTP
+static err_t http_recv_callback(void *arg, struct altcp_pcb *tpcb, struct pbuf *p, err_t err) {
+    http_request_t *req = (http_request_t *)arg;
+    if (req == NULL || req->pcb != tpcb) {
+        // Conexão que já foi encerrada -> descarta o que chegar
+        if (p != NULL) {
+            altcp_recved(tpcb, p->tot_len);
+            pbuf_free(p);
+        }
+        return ERR_OK;
+    }
+    if (p == NULL) {
+        hooks->received(tpcb, req->kind, NULL);
+        return http_request_finish(req, false, REQUEST_DONE);
+    }
+    req->phase = PHASE_RECEIVING; // Primeiro byte chegou -> vale só o prazo total
+    bool accepted = hooks->received(tpcb, req->kind, p);
+    altcp_recved(tpcb, p->tot_len); // Libera a janela TCP para o servidor continuar enviando
+    pbuf_free(p);
+    return accepted ? ERR_OK : http_request_finish(req, true, REQUEST_ABORTED);
+}
+
+// Função de callback para conexão com o servidor (no HTTPS, chamada após o handshake)
+static err_t http_connected_callback(void *arg, struct altcp_pcb *tpcb, err_t err) {
+    http_request_t *req = (http_request_t *)arg;
+    if (req == NULL || req->pcb != tpcb) {
+        return ERR_OK;
+    }
+    if (err != ERR_OK) {
+        stats.failed++;
+        stats.last_error = err;
+        return http_request_finish(req, false, REQUEST_FAILED);
+    }
+    req->phase = PHASE_WAITING;
+    req->phase_deadline = make_timeout_time_ms(HTTP_TTFB_TIMEOUT_MS);
+    altcp_recv(tpcb, http_recv_callback); // Aguarda a resposta do servidor
+    hooks->connected(tpcb, req->kind);
+    return ERR_OK;
+}
+
+// Função de callback para erros fatais da conexão (o PCB já foi liberado pelo lwIP)
+static void http_error_callback(void *arg, err_t err) {
+    http_request_t *req = (http_request_t *)arg;
+    if (req == NULL) {
+        return;
+    }
+    stats.failed++;
+    stats.last_error = err;
+    req->pcb = NULL; // Já liberado -> http_request_end não mexe nele
+    http_request_finish(req, false, REQUEST_FAILED);
+}
+
+// Função de callback periódica: aborta a requisição que estourar o prazo da fase ou o total
+static err_t http_poll_callback(void *arg, struct altcp_pcb *tpcb) {
+    http_request_t *req = (http_request_t *)arg;
+    if (req == NULL || req->pcb != tpcb) {
+        return ERR_OK;
+    }
+    absolute_time_t now = get_absolute_time();
+    bool phase_expired = req->phase != PHASE_RECEIVING && absolute_time_diff_us(req->phase_deadline, now) >= 0;
+    bool total_expired = absolute_time_diff_us(req->started, now) >= HTTP_TOTAL_TIMEOUT_MS * 1000ll;
+    if (!phase_expired && !total_expired) {
+        return ERR_OK;
+    }
+    request_result_t result = !phase_expired ? REQUEST_TIMEOUT_TOTAL :
+                              req->phase == PHASE_CONNECTING ? REQUEST_TIMEOUT_CONNECT : REQUEST_TIMEOUT_FIRST_BYTE;
+    stats.timed_out++;
+    return http_request_finish(req, true, result);
+}
+
+// Função para iniciar uma requisição HTTP. Se já houver uma em andamento o disparo se junta a
+// ela, então nunca há duas conexões escrevendo no mesmo buffer. Retorna true se abriu uma conexão.
+bool http_request_start(request_kind_t kind) {
+    if (request.phase != PHASE_IDLE) {
+        stats.coalesced++;
+        if (kind == REQUEST_WEATHER && request.kind == REQUEST_FORECAST) {
+            request.weather_pending = true;
+        }
+        return false;
+    }
+
+    struct altcp_pcb *pcb = hooks->open(kind);
+    if (pcb == NULL) {
+        return false;
+    }
+    stats.made++;
+    request.pcb = pcb;
+    request.kind = kind;
+    request.phase = PHASE_CONNECTING;
+    request.started = get_absolute_time();
+    request.phase_deadline = make_timeout_time_ms(HTTP_CONNECT_TIMEOUT_MS);
+
+    altcp_arg(pcb, &request);
+    altcp_err(pcb, http_error_callback);
+    altcp_poll(pcb, http_poll_callback, HTTP_POLL_INTERVAL);
+    err_t err = altcp_connect(pcb, &server_ip, server_port, http_connected_callback);
+    if (err != ERR_OK) {
+        stats.failed++;
+        stats.last_error = err;
+        http_request_finish(&request, true, REQUEST_FAILED);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,69 @@
+#ifndef HTTP_REQUEST_H
+#define HTTP_REQUEST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+#include "lwip/altcp.h"
+
+// Requisição à API, uma por vez: disparos durante a requisição se juntam a ela (a observação
+// pedida durante a previsão é feita logo depois) e cada fase tem seu prazo, verificado pelo
+// poll do TCP. O que é específico da aplicação (criar a conexão TLS, escrever a requisição,
+// decodificar a resposta, reagir ao resultado) fica nos ganchos passados a http_request_init.
+
+// Prazos da requisição HTTP
+#define HTTP_CONNECT_TIMEOUT_MS 10000   // Conexão + handshake
+#define HTTP_TTFB_TIMEOUT_MS 10000      // Requisição enviada até o primeiro byte da resposta
+#define HTTP_TOTAL_TIMEOUT_MS 30000     // Requisição inteira
+#define HTTP_POLL_INTERVAL 2            // Verificação dos prazos, em ciclos de 500 ms do TCP
+
+// Tipos de requisição à API
+typedef enum {
+    REQUEST_WEATHER,    // Observação atual (/weather)
+    REQUEST_FORECAST    // Previsão de 3 em 3 horas (/forecast)
+} request_kind_t;
+
+// Fases de uma requisição, cada uma com seu prazo
+typedef enum {
+    PHASE_IDLE,
+    PHASE_CONNECTING,   // TCP + handshake TLS
+    PHASE_WAITING,      // Requisição enviada, aguardando o primeiro byte
+    PHASE_RECEIVING     // Recebendo a resposta
+} request_phase_t;
+
+// Como a requisição terminou (gancho finished)
+typedef enum {
+    REQUEST_DONE,               // Servidor fechou a conexão depois da resposta
+    REQUEST_FAILED,             // Erro fatal da conexão (RST, handshake recusado, connect falhou)
+    REQUEST_ABORTED,            // Gancho received recusou a resposta
+    REQUEST_TIMEOUT_CONNECT,    // Prazos: conexão + handshake
+    REQUEST_TIMEOUT_FIRST_BYTE, //         primeiro byte da resposta
+    REQUEST_TIMEOUT_TOTAL       //         requisição inteira
+} request_result_t;
+
+typedef struct {
+    // Cria a conexão (TLS ou TCP) e prepara a resposta; NULL = sem memória para o PCB
+    struct altcp_pcb *(*open)(request_kind_t kind);
+    // Conexão pronta: escreve a requisição
+    void (*connected)(struct altcp_pcb *pcb, request_kind_t kind);
+    // Pedaço da resposta (p == NULL: servidor fechou). Os pbufs são devolvidos pelo módulo;
+    // retornar false aborta a conexão com REQUEST_ABORTED
+    bool (*received)(struct altcp_pcb *pcb, request_kind_t kind, struct pbuf *p);
+    // Requisição encerrada e conexão liberada; pode iniciar outra (ex.: previsão em seguida)
+    void (*finished)(request_kind_t kind, request_result_t result);
+} http_request_hooks_t;
+
+typedef struct {
+    uint32_t made;          // Requisições feitas à API
+    uint32_t coalesced;     // Disparos atendidos pela requisição que já estava em andamento
+    uint32_t timed_out;     // Requisições abortadas por prazo
+    uint32_t failed;        // Requisições encerradas por erro da conexão
+    err_t last_error;       // Erro da última falha
+} http_request_stats_t;
+
+void http_request_init(const http_request_hooks_t *hooks, const ip_addr_t *server, u16_t port);
+bool http_request_start(request_kind_t kind);
+bool http_request_busy(void);
+const http_request_stats_t *http_request_stats(void);
+
+#endif
@@ -0,0 +1,337 @@
+#include <string.h>
+#include "inflate.h"
+
+// Estados do descompressor
+enum {
+    ST_HEADER,      // BFINAL + BTYPE
+    ST_STORED_LEN,  // LEN/NLEN de um bloco sem compressão
+    ST_STORED,      // Bytes de um bloco sem compressão
+    ST_TABLE,       // HLIT/HDIST/HCLEN de um bloco dinâmico
+    ST_CODELENS,    // Comprimentos do código de comprimentos
+    ST_LENS,        // Comprimentos dos códigos literal/distância
+    ST_CODES,       // Símbolos comprimidos
+    ST_DONE,
+    ST_ERROR
+};
+
+// Retornos internos de cada passo
+#define NEED_MORE -1
+#define BAD_DATA -2
+
+#define MAXBITS 15
+
+static const uint16_t length_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8_t length_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16_t dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+    8193, 12289, 16385, 24577};
+static const uint8_t dist_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+static const uint8_t codelen_order[19] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+void inflate_init(inflate_t *s, inflate_sink_t sink, void *ctx) {
+    memset(s, 0, sizeof(*s));
+    s->state = ST_HEADER;
+    s->sink = sink;
+    s->ctx = ctx;
+}
+
+// Próximo byte da entrada: primeiro o que sobrou do pedaço anterior, depois o atual
+static int next_byte(inflate_t *s) {
+    if (s->carry_pos < s->carry_len) {
+        return s->carry[s->carry_pos++];
+    }
+    if (s->in_pos < s->in_len) {
+        return s->in[s->in_pos++];
+    }
+    return NEED_MORE;
+}
+
+// Lê 'need' bits (até 16), LSB primeiro
+static int bits(inflate_t *s, uint8_t need) {
+    while (s->bitcnt < need) {
+        int byte = next_byte(s);
+        if (byte < 0) {
+            return NEED_MORE;
+        }
+        s->bitbuf |= (uint32_t)byte << s->bitcnt;
+        s->bitcnt += 8;
+    }
+    int value = s->bitbuf & ((1u << need) - 1);
+    s->bitbuf >>= need;
+    s->bitcnt -= need;
+    return value;
+}
+
+// Escreve um byte na janela, repassando ao sink quando a janela dá a volta
+static void put(inflate_t *s, uint8_t byte) {
+    s->window[s->wpos++] = byte;
+    s->total_out++;
+    if (s->wpos == INFLATE_WINDOW_SIZE) {
+        s->sink(s->ctx, s->window + s->flushed, INFLATE_WINDOW_SIZE - s->flushed);
+        s->wpos = 0;
+        s->flushed = 0;
+    }
+}
+
+static void flush(inflate_t *s) {
+    if (s->wpos > s->flushed) {
+        s->sink(s->ctx, s->window + s->flushed, s->wpos - s->flushed);
+        s->flushed = s->wpos;
+    }
+}
+
+// Monta a tabela canônica; retorna < 0 se o código tiver excesso de símbolos
+static int construct(uint16_t *count, uint16_t *symbol, const uint8_t *length, uint16_t n) {
+    uint16_t offs[MAXBITS + 1];
+
+    memset(count, 0, (MAXBITS + 1) * sizeof(uint16_t));
+    for (uint16_t sym = 0; sym < n; sym++) {
+        count[length[sym]]++;
+    }
+    if (count[0] == n) {
+        return 0;
+    }
+    int left = 1;
+    for (uint8_t len = 1; len <= MAXBITS; len++) {
+        left <<= 1;
+        left -= count[len];
+        if (left < 0) {
+            return -1;
+        }
+    }
+    offs[1] = 0;
+    for (uint8_t len = 1; len < MAXBITS; len++) {
+        offs[len + 1] = offs[len] + count[len];
+    }
+    for (uint16_t sym = 0; sym < n; sym++) {
+        if (length[sym] != 0) {
+            symbol[offs[length[sym]]++] = sym;
+        }
+    }
+    return left;
+}
+
+// Decodifica um símbolo bit a bit (sem tabela de atalho -> pouca RAM)
+static int decode(inflate_t *s, const uint16_t *count, const uint16_t *symbol) {
+    int code = 0, first = 0, index = 0;
+    for (uint8_t len = 1; len <= MAXBITS; len++) {
+        int bit = bits(s, 1);
+        if (bit < 0) {
+            return bit;
+        }
+        code |= bit;
+        int n = count[len];
+        if (code - n < first) {
+            return symbol[index + (code - first)];
+        }
+        index += n;
+        first += n;
+        first <<= 1;
+        code <<= 1;
+    }
+    return BAD_DATA;
+}
+
+static void fixed_tables(inflate_t *s) {
+    uint16_t sym = 0;
+    for (; sym < 144; sym++) s->lengths[sym] = 8;
+    for (; sym < 256; sym++) s->lengths[sym] = 9;
+    for (; sym < 280; sym++) s->lengths[sym] = 7;
+    for (; sym < 288; sym++) s->lengths[sym] = 8;
+    construct(s->lencount, s->lensym, s->lengths, 288);
+    memset(s->lengths, 5, 30);
+    construct(s->distcount, s->distsym, s->lengths, 30);
+}
+
+// Executa um passo indivisível: ou consome todos os bits de que precisa, ou retorna
+// NEED_MORE sem ter produzido saída (o chamador desfaz a leitura)
+static int step(inflate_t *s) {
+    int value;
+
+    switch (s->state) {
+        case ST_HEADER:
+            if ((value = bits(s, 3)) < 0) return value;
+            s->final = value & 1;
+            switch (value >> 1) {
+                case 0:
+                    s->bitbuf = 0;  // Blocos sem compressão começam alinhados ao byte
+                    s->bitcnt = 0;
+                    s->state = ST_STORED_LEN;
+                    break;
+                case 1:
+                    fixed_tables(s);
+                    s->state = ST_CODES;
+                    break;
+                case 2:
+                    s->state = ST_TABLE;
+                    break;
+                default:
+                    return BAD_DATA;
+            }
+            return 0;
+
+        case ST_STORED_LEN: {
+            int len, nlen;
+            if ((len = bits(s, 16)) < 0) return len;
+            if ((nlen = bits(s, 16)) < 0) return nlen;
+            if (len != (~nlen & 0xFFFF)) return BAD_DATA;
+            s->stored_left = len;
+            s->state = len ? ST_STORED : (s->final ? ST_DONE : ST_HEADER);
+            return 0;
+        }
+
+        case ST_STORED:
+            if ((value = bits(s, 8)) < 0) return value;
+            put(s, value);
+            if (--s->stored_left == 0) {
+                s->state = s->final ? ST_DONE : ST_HEADER;
+            }
+            return 0;
+
+        case ST_TABLE: {
+            if ((value = bits(s, 14)) < 0) return value;
+            s->nlen = (value & 0x1F) + 257;
+            s->ndist = ((value >> 5) & 0x1F) + 1;
+            s->ncode = (value >> 10) + 4;
+            if (s->nlen > 286 || s->ndist > 30) return BAD_DATA;
+            memset(s->lengths, 0, 19);
+            s->index = 0;
+            s->state = ST_CODELENS;
+            return 0;
+        }
+
+        case ST_CODELENS:
+            if ((value = bits(s, 3)) < 0) return value;
+            s->lengths[codelen_order[s->index++]] = value;
+            if (s->index == s->ncode) {
+                // O código de comprimentos ocupa temporariamente a tabela literal/comprimento
+                if (construct(s->lencount, s->lensym, s->lengths, 19) != 0) return BAD_DATA;
+                s->index = 0;
+                s->state = ST_LENS;
+            }
+            return 0;
+
+        case ST_LENS: {
+            int sym = decode(s, s->lencount, s->lensym);
+            if (sym < 0) return sym;
+            uint8_t len = 0;
+            int repeat;
+            if (sym < 16) {
+                len = sym;
+                repeat = 1;
+            } else if (sym == 16) {
+                if (s->index == 0) return BAD_DATA;
+                len = s->lengths[s->index - 1];
+                if ((repeat = bits(s, 2)) < 0) return repeat;
+                repeat += 3;
+            } else if (sym == 17) {
+                if ((repeat = bits(s, 3)) < 0) return repeat;
+                repeat += 3;
+            } else {
+                if ((repeat = bits(s, 7)) < 0) return repeat;
+                repeat += 11;
+            }
+            if (s->index + repeat > s->nlen + s->ndist) return BAD_DATA;
+            while (repeat--) {
+                s->lengths[s->index++] = len;
+            }
+            if (s->index == s->nlen + s->ndist) {
+                if (s->lengths[256] == 0) return BAD_DATA;  // Sem símbolo de fim de bloco
+                if (construct(s->lencount, s->lensym, s->lengths, s->nlen) < 0) return BAD_DATA;
+                if (construct(s->distcount, s->distsym, s->lengths + s->nlen, s->ndist) < 0) return BAD_DATA;
+                s->state = ST_CODES;
+            }
+            return 0;
+        }
+
+        case ST_CODES: {
+            int sym = decode(s, s->lencount, s->lensym);
+            if (sym < 0) return sym;
+            if (sym < 256) {
+                put(s, sym);
+                return 0;
+            }
+            if (sym == 256) {
+                s->state = s->final ? ST_DONE : ST_HEADER;
+                return 0;
+            }
+            sym -= 257;
+            if (sym >= 29) return BAD_DATA;
+            int extra, len, dist;
+            if ((extra = bits(s, length_extra[sym])) < 0) return extra;
+            len = length_base[sym] + extra;
+            if ((sym = decode(s, s->distcount, s->distsym)) < 0) return sym;
+            if (sym >= 30) return BAD_DATA;
+            if ((extra = bits(s, dist_extra[sym])) < 0) return extra;
+            dist = dist_base[sym] + extra;
+            if ((uint32_t)dist > s->total_out || (uint32_t)dist > INFLATE_WINDOW_SIZE) return BAD_DATA;
+            // Todos os bits foram lidos -> a cópia não pode mais ser interrompida
+            while (len--) {
+                put(s, s->window[(s->wpos - dist) & (INFLATE_WINDOW_SIZE - 1)]);
+            }
+            return 0;
+        }
+
+        default:
+            return BAD_DATA;
+    }
+}
+
+inflate_status_t inflate_feed(inflate_t *s, const uint8_t *data, size_t len) {
+    if (s->state == ST_ERROR) {
+        return INFLATE_ERROR;
+    }
+    s->in = data;
+    s->in_len = len;
+    s->in_pos = 0;
+    s->carry_pos = 0;
+
+    while (s->state != ST_DONE) {
+        // Ponto de retorno caso a entrada acabe no meio do passo
+        uint32_t bitbuf = s->bitbuf;
+        uint8_t bitcnt = s->bitcnt;
+        uint8_t carry_pos = s->carry_pos;
+        size_t in_pos = s->in_pos;
+
+        int ret = step(s);
+        if (ret == NEED_MORE) {
+            s->bitbuf = bitbuf;
+            s->bitcnt = bitcnt;
+            s->carry_pos = carry_pos;
+            s->in_pos = in_pos;
+            break;
+        }
+        if (ret == BAD_DATA) {
+            s->state = ST_ERROR;
+            flush(s);
+            return INFLATE_ERROR;
+        }
+    }
+
+    // Guarda os bytes ainda não consumidos (no máximo um passo, < 8 bytes)
+    size_t pending = (s->carry_len - s->carry_pos) + (s->in_len - s->in_pos);
+    if (s->state != ST_DONE) {
+        if (pending > sizeof(s->carry)) {
+            s->state = ST_ERROR;
+            flush(s);
+            return INFLATE_ERROR;
+        }
+        memmove(s->carry, s->carry + s->carry_pos, s->carry_len - s->carry_pos);
+        memcpy(s->carry + (s->carry_len - s->carry_pos), s->in + s->in_pos, s->in_len - s->in_pos);
+        s->carry_len = pending;
+    }
+    s->carry_pos = 0;
+    s->in = NULL;
+    s->in_len = s->in_pos = 0;
+
+    flush(s);
+    return s->state == ST_DONE ? INFLATE_DONE : INFLATE_OK;
+}
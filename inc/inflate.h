@@ -0,0 +1,59 @@
+#ifndef INFLATE_H
+#define INFLATE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Descompressor DEFLATE (RFC 1951) incremental, alimentado com pedaços arbitrários
+// (ex.: o payload de cada pbuf). A saída é entregue ao sink em blocos contíguos.
+//
+// Orçamento de RAM: janela de INFLATE_WINDOW_SIZE bytes + ~1 KB de tabelas/estado.
+// Referências para trás maiores que a janela geram INFLATE_ERROR; respostas de até
+// INFLATE_WINDOW_SIZE bytes sempre cabem, não importa a janela usada pelo servidor.
+#ifndef INFLATE_WINDOW_BITS
+#define INFLATE_WINDOW_BITS 12
+#endif
+#define INFLATE_WINDOW_SIZE (1u << INFLATE_WINDOW_BITS)
+
+typedef void (*inflate_sink_t)(void *ctx, const uint8_t *data, size_t len);
+
+typedef enum {
+    INFLATE_OK,     // Consumiu toda a entrada, aguardando mais
+    INFLATE_DONE,   // Último bloco concluído (bytes seguintes são ignorados)
+    INFLATE_ERROR   // Fluxo inválido ou referência fora da janela
+} inflate_status_t;
+
+typedef struct {
+    // Leitor de bits; bytes de um passo interrompido ficam em carry até o próximo pedaço
+    uint32_t bitbuf;
+    uint8_t bitcnt;
+    uint8_t carry[16];
+    uint8_t carry_len, carry_pos;
+    const uint8_t *in;
+    size_t in_len, in_pos;
+
+    // Estado do bloco atual
+    uint8_t state;
+    bool final;
+    uint16_t stored_left;
+    uint16_t nlen, ndist, ncode, index;
+    uint8_t lengths[320];
+
+    // Códigos de Huffman canônicos (contagem por comprimento + símbolos ordenados)
+    uint16_t lencount[16], lensym[288];
+    uint16_t distcount[16], distsym[30];
+
+    // Janela circular de saída
+    uint8_t window[INFLATE_WINDOW_SIZE];
+    uint16_t wpos, flushed;
+    uint32_t total_out;
+
+    inflate_sink_t sink;
+    void *ctx;
+} inflate_t;
+
+void inflate_init(inflate_t *s, inflate_sink_t sink, void *ctx);
+inflate_status_t inflate_feed(inflate_t *s, const uint8_t *data, size_t len);
+
+#endif
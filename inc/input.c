@@ -0,0 +1,88 @@
+#include "input.h"
+#include "debounce.h"
+#include "hardware/gpio.h"
+#include "hardware/sync.h"
+
+// Filas SPSC sem lock: um produtor e um consumidor, índices escritos por um lado só
+#define EDGE_QUEUE_SIZE 32      // Potência de 2
+#define EVENT_QUEUE_SIZE 16     // Potência de 2
+
+typedef struct {
+    uint8_t gpio;
+    uint64_t time_us;
+} edge_t;
+
+// IRQ de GPIO -> timer
+static edge_t edges[EDGE_QUEUE_SIZE];
+static volatile uint8_t edge_head = 0, edge_tail = 0;
+
+// Timer -> main
+static input_event_t events[EVENT_QUEUE_SIZE];
+static volatile uint8_t event_head = 0, event_tail = 0;
+
+static debounce_t pins_state[INPUT_MAX_PINS];  // Estado de debounce de cada pino
+static uint8_t pin_count = 0;
+static repeating_timer_t debounce_timer;
+
+// Callback da IRQ de GPIO: apenas registra a borda com o instante atual
+static void input_gpio_irq(uint gpio, uint32_t events_mask) {
+    uint8_t next = (edge_head + 1) & (EDGE_QUEUE_SIZE - 1);
+    if (next == edge_tail) {
+        return; // Fila cheia: o nível é relido no debounce, então nenhum toque se perde
+    }
+    edges[edge_head] = (edge_t){gpio, time_us_64()};
+    __mem_fence_release();
+    edge_head = next;
+}
+
+static void push_event(uint8_t gpio, input_event_type_t type, uint32_t time_ms) {
+    uint8_t next = (event_head + 1) & (EVENT_QUEUE_SIZE - 1);
+    if (next == event_tail) {
+        return; // Main atrasado: descarta o evento mais novo
+    }
+    events[event_head] = (input_event_t){gpio, type, time_ms};
+    __mem_fence_release();
+    event_head = next;
+}
+
+// Callback do timer: consome as bordas e atualiza a máquina de estados de cada pino
+static bool input_debounce_tick(repeating_timer_t *timer) {
+    while (edge_tail != edge_head) {
+        __mem_fence_acquire();
+        edge_t edge = edges[edge_tail];
+        edge_tail = (edge_tail + 1) & (EDGE_QUEUE_SIZE - 1);
+        for (uint8_t i = 0; i < pin_count; i++) {
+            if (pins_state[i].gpio == edge.gpio) {
+                debounce_edge(&pins_state[i], edge.time_us);
+            }
+        }
+    }
+
+    uint64_t now_us = time_us_64();
+    for (uint8_t i = 0; i < pin_count; i++) {
+        bool pressed = !gpio_get(pins_state[i].gpio); // Pull-up -> pressionado em nível baixo
+        debounce_tick(&pins_state[i], pressed, now_us, push_event);
+    }
+    return true;
+}
+
+// Função para registrar os pinos (já configurados como entrada com pull-up) e iniciar o timer
+void input_init(const uint *pins, uint8_t count) {
+    pin_count = count < INPUT_MAX_PINS ? count : INPUT_MAX_PINS;
+    for (uint8_t i = 0; i < pin_count; i++) {
+        debounce_init(&pins_state[i], pins[i], !gpio_get(pins[i]));
+        gpio_set_irq_enabled_with_callback(pins[i], GPIO_IRQ_EDGE_FALL | GPIO_IRQ_EDGE_RISE, true, &input_gpio_irq);
+    }
+    add_repeating_timer_ms(INPUT_TICK_MS, input_debounce_tick, NULL, &debounce_timer);
+}
+
+// Função para retirar o próximo evento da fila (chamada no contexto principal)
+bool input_poll(input_event_t *event) {
+    if (event_tail == event_head) {
+        return false;
+    }
+    __mem_fence_acquire();
+    *event = events[event_tail];
+    event_tail = (event_tail + 1) & (EVENT_QUEUE_SIZE - 1);
+    return true;
+}
@@ -0,0 +1,34 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+// Subsistema de entrada dos botões (ativos em nível baixo, com pull-up).
+// A IRQ de GPIO só registra o instante de cada borda numa fila sem lock; um timer
+// de hardware faz o debounce por pino e gera eventos tipados, consumidos no main.
+
+#define INPUT_MAX_PINS 4
+#define INPUT_TICK_MS 2             // Período do timer de debounce
+#define INPUT_DEBOUNCE_US 5000      // Tempo sem bordas para considerar o nível estável
+#define INPUT_LONG_PRESS_MS 800     // Tempo pressionado até gerar INPUT_LONG_PRESS
+#define INPUT_REPEAT_MS 200         // Intervalo de INPUT_REPEAT após o long-press
+
+typedef enum {
+    INPUT_PRESS,
+    INPUT_RELEASE,
+    INPUT_LONG_PRESS,
+    INPUT_REPEAT
+} input_event_type_t;
+
+typedef struct {
+    uint8_t gpio;
+    input_event_type_t type;
+    uint32_t time_ms;   // Instante da borda (press/release) ou do disparo (long/repeat), ms desde o boot
+} input_event_t;
+
+void input_init(const uint *pins, uint8_t count);
+bool input_poll(input_event_t *event);
+
+#endif
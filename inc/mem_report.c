@@ -0,0 +1,84 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <malloc.h>
+#include "pico/stdlib.h"
+#include "pico/cyw43_arch.h"
+#include "lwip/stats.h"
+#include "lwip/memp.h"
+#include "mem_report.h"
+
+// Padrão usado para pintar a pilha livre; a marca d'água é o primeiro word alterado
+#define STACK_PAINT 0xC5C5C5C5u
+#define STACK_MARGIN 64     // Bytes abaixo do SP atual que não são pintados (frame desta função)
+
+// Limites da pilha do core 0, definidos pelo linker script do SDK
+extern uint32_t __StackBottom;
+extern uint32_t __StackTop;
+
+typedef struct {
+    const char *name;
+    size_t size;
+    mem_report_high_water_fn high_water;
+} arena_t;
+
+static arena_t arenas[MEM_REPORT_MAX_ARENAS];
+static uint8_t arena_count = 0;
+static size_t heap_after_init = 0;
+
+// Função para pintar a pilha ainda não usada (chamar no início do main)
+void mem_report_init(void) {
+    uint32_t marker;
+    uint32_t *end = (uint32_t *)((uintptr_t)&marker - STACK_MARGIN);
+    for (uint32_t *p = &__StackBottom; p < end; p++) {
+        *p = STACK_PAINT;
+    }
+}
+
+// Função para registrar o fim da inicialização: a partir daqui o heap não deve crescer
+void mem_report_end_init(void) {
+    heap_after_init = mallinfo().uordblks;
+}
+
+void mem_report_add_arena(const char *name, size_t size, mem_report_high_water_fn high_water) {
+    if (arena_count < MEM_REPORT_MAX_ARENAS) {
+        arenas[arena_count++] = (arena_t){name, size, high_water};
+    }
+}
+
+static size_t stack_high_water(void) {
+    uint32_t *p = &__StackBottom;
+    while (p < &__StackTop && *p == STACK_PAINT) {
+        p++;
+    }
+    return (uintptr_t)&__StackTop - (uintptr_t)p;
+}
+
+// Função para imprimir o relatório no monitor serial
+void mem_report_print(void) {
+    printf("--- Memoria (usado/max/total) ---\n");
+
+    cyw43_arch_lwip_begin();
+    printf("lwIP heap: %u/%u/%u bytes, erros %u\n",
+           (unsigned)lwip_stats.mem.used, (unsigned)lwip_stats.mem.max,
+           (unsigned)lwip_stats.mem.avail, (unsigned)lwip_stats.mem.err);
+    for (int i = 0; i < MEMP_MAX; i++) {
+        const struct stats_mem *pool = lwip_stats.memp[i];
+        if (pool != NULL && pool->max > 0) {
+            printf("  %-16s %u/%u/%u, erros %u\n", pool->name,
+                   (unsigned)pool->used, (unsigned)pool->max, (unsigned)pool->avail, (unsigned)pool->err);
+        }
+    }
+    cyw43_arch_lwip_end();
+
+    printf("Pilha core0: %u/%u bytes\n", (unsigned)stack_high_water(),
+           (unsigned)((uintptr_t)&__StackTop - (uintptr_t)&__StackBottom));
+
+    size_t heap_now = mallinfo().uordblks;
+    printf("Heap C: %u bytes (apos init: %u)%s\n", (unsigned)heap_now, (unsigned)heap_after_init,
+           heap_now > heap_after_init ? " <- alocacao apos init!" : "");
+
+    for (uint8_t i = 0; i < arena_count; i++) {
+        printf("Arena %-12s %u/%u bytes\n", arenas[i].name,
+               (unsigned)arenas[i].high_water(), (unsigned)arenas[i].size);
+    }
+}
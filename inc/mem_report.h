@@ -0,0 +1,19 @@
+#ifndef MEM_REPORT_H
+#define MEM_REPORT_H
+
+#include <stddef.h>
+
+// Relatório de uso de memória: marcas d'água dos pools do lwIP, da pilha (por pintura),
+// do heap e das arenas estáticas registradas pelos subsistemas.
+
+#define MEM_REPORT_MAX_ARENAS 4
+
+// Retorna o maior uso (em bytes) já observado na arena
+typedef size_t (*mem_report_high_water_fn)(void);
+
+void mem_report_init(void);
+void mem_report_end_init(void);
+void mem_report_add_arena(const char *name, size_t size, mem_report_high_water_fn high_water);
+void mem_report_print(void);
+
+#endif
@@ -0,0 +1,37 @@
+#include <string.h>
+#include "response_buffer.h"
+
+static char response_buffer[RESPONSE_BUFFER_SIZE] = {0};
+static size_t response_index = 0;  // Índice atual do buffer -> auxiliar a percorrer o buffer
+static size_t response_high_water = 0;
+
+void response_buffer_reset(void) {
+    response_index = 0;
+    response_buffer[0] = '\0';
+}
+
+// Função que recebe o corpo já decodificado e acumula no buffer da resposta
+void response_sink(void *ctx, const uint8_t *data, size_t len) {
+    // Certifica de não ultrapassar o tamanho do buffer
+    if (response_index + len > RESPONSE_BUFFER_SIZE - 1) {
+        len = RESPONSE_BUFFER_SIZE - 1 - response_index;
+    }
+    memcpy(response_buffer + response_index, data, len);
+    response_index += len;
+    response_buffer[response_index] = '\0';  // Finaliza a string
+    if (response_index > response_high_water) {
+        response_high_water = response_index;
+    }
+}
+
+const char *response_buffer_text(void) {
+    return response_buffer;
+}
+
+size_t response_buffer_length(void) {
+    return response_index;
+}
+
+size_t response_buffer_high_water(void) {
+    return response_high_water;
+}
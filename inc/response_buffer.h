@@ -0,0 +1,18 @@
+#ifndef RESPONSE_BUFFER_H
+#define RESPONSE_BUFFER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Buffer estático do corpo da observação (/weather), já decodificado pelo http_body. O excesso
+// além de RESPONSE_BUFFER_SIZE - 1 bytes é descartado; o texto fica sempre terminado em '\0'.
+
+#define RESPONSE_BUFFER_SIZE 1024
+
+void response_buffer_reset(void);
+void response_sink(void *ctx, const uint8_t *data, size_t len);     // Sink do http_body
+const char *response_buffer_text(void);
+size_t response_buffer_length(void);
+size_t response_buffer_high_water(void);    // Maior resposta já recebida -> relatório de memória
+
+#endif
@@ -1,6 +1,12 @@
 #include "ssd1306.h"
 #include "font.h"
 
+// Framebuffer estático (byte de controle 0x40 + páginas do display), sem heap
+static uint8_t ssd1306_buffer[WIDTH * HEIGHT / 8 + 1];
+
+static const uint32_t ssd1306_speeds[] = SSD1306_I2C_SPEEDS;
+#define SSD1306_SPEED_COUNT (sizeof(ssd1306_speeds) / sizeof(ssd1306_speeds[0]))
+
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
   ssd->width = width;
   ssd->height = height;
@@ -8,9 +14,84 @@ void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_v
   ssd->address = address;
   ssd->i2c_port = i2c;
   ssd->bufsize = ssd->pages * ssd->width + 1;
-  ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
+  hard_assert(ssd->bufsize <= sizeof(ssd1306_buffer));
+  ssd->ram_buffer = ssd1306_buffer;
   ssd->ram_buffer[0] = 0x40;
   ssd->port_buffer[0] = 0x80;
+  ssd->speed_index = 0;
+  ssd->speed_max = 0;
+  ssd->clean_writes = 0;
+  ssd->baudrate = i2c_set_baudrate(i2c, ssd1306_speeds[0]); // Começa na velocidade mais segura
+  ssd->i2c_errors = 0;
+  ssd->i2c_retries = 0;
+}
+
+// Prazo de uma transação: dobro do tempo nominal (9 bits por byte) + 1 ms de folga
+static uint32_t ssd1306_timeout_us(ssd1306_t *ssd, size_t len) {
+  return (uint32_t)((uint64_t)len * 9 * 2000000 / ssd->baudrate) + 1000;
+}
+
+static void ssd1306_set_speed(ssd1306_t *ssd, uint8_t index) {
+  ssd->speed_index = index;
+  ssd->clean_writes = 0;
+  ssd->baudrate = i2c_set_baudrate(ssd->i2c_port, ssd1306_speeds[index]);
+}
+
+// Escrita única; em NAK ou timeout contabiliza o erro e desce uma velocidade. Depois de
+// SSD1306_I2C_STEP_UP_AFTER escritas sem erro sobe uma, até a velocidade da calibração, para
+// que erros passageiros não deixem o barramento em 100 kHz para sempre.
+static bool ssd1306_write(ssd1306_t *ssd, const uint8_t *src, size_t len) {
+  int ret = i2c_write_timeout_us(ssd->i2c_port, ssd->address, src, len, false, ssd1306_timeout_us(ssd, len));
+  if (ret == (int)len) {
+    if (ssd->speed_index < ssd->speed_max && ++ssd->clean_writes >= SSD1306_I2C_STEP_UP_AFTER) {
+      ssd1306_set_speed(ssd, ssd->speed_index + 1);
+    }
+    return true;
+  }
+  ssd->i2c_errors++;
+  if (ssd->speed_index > 0) {
+    ssd1306_set_speed(ssd, ssd->speed_index - 1);
+  }
+  return false;
+}
+
+static bool ssd1306_try_command(ssd1306_t *ssd, uint8_t command) {
+  ssd->port_buffer[1] = command;
+  return ssd1306_write(ssd, ssd->port_buffer, 2);
+}
+
+// Testa a velocidade atual: comando inofensivo + leitura do byte de status.
+// Com o display ligado o bit 6 (display OFF) do status deve estar zerado.
+static bool ssd1306_probe(ssd1306_t *ssd) {
+  uint8_t status;
+  ssd->port_buffer[1] = SET_ENTIRE_ON;
+  if (i2c_write_timeout_us(ssd->i2c_port, ssd->address, ssd->port_buffer, 2, false, ssd1306_timeout_us(ssd, 2)) != 2) {
+    return false;
+  }
+  if (i2c_read_timeout_us(ssd->i2c_port, ssd->address, &status, 1, false, ssd1306_timeout_us(ssd, 1)) != 1) {
+    return false;
+  }
+  return (status & 0x40) == 0;
+}
+
+// Sobe a velocidade enquanto todas as tentativas passam e fica na última confiável.
+// Chamar depois de ssd1306_config (display ligado). Retorna a velocidade escolhida.
+uint32_t ssd1306_calibrate(ssd1306_t *ssd) {
+  uint8_t best = 0;
+  for (uint8_t index = 0; index < SSD1306_SPEED_COUNT; index++) {
+    ssd1306_set_speed(ssd, index);
+    bool reliable = true;
+    for (uint8_t trial = 0; trial < SSD1306_CALIBRATION_TRIALS && reliable; trial++) {
+      reliable = ssd1306_probe(ssd);
+    }
+    if (!reliable) {
+      break;
+    }
+    best = index;
+  }
+  ssd->speed_max = best;
+  ssd1306_set_speed(ssd, best);
+  return ssd->baudrate;
 }
 
 void ssd1306_config(ssd1306_t *ssd) {
@@ -42,30 +123,34 @@ void ssd1306_config(ssd1306_t *ssd) {
 }
 
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
-  ssd->port_buffer[1] = command;
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->port_buffer,
-    2,
-    false
-  );
+  for (uint8_t attempt = 0; attempt <= SSD1306_I2C_RETRIES; attempt++) {
+    if (ssd1306_try_command(ssd, command)) {
+      return;
+    }
+    ssd->i2c_retries++;
+  }
 }
 
 void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->ram_buffer,
-    ssd->bufsize,
-    false
-  );
+  ssd1306_send_frame(ssd, ssd->ram_buffer);
+}
+
+// Envia um quadro completo (0x40 + páginas) sem passar pelo framebuffer,
+// ex.: direto da flash (XIP) para as telas pré-geradas
+void ssd1306_send_frame(ssd1306_t *ssd, const uint8_t *frame) {
+  // Em caso de erro a transação inteira (endereçamento + dados) é repetida, já mais devagar
+  for (uint8_t attempt = 0; attempt <= SSD1306_I2C_RETRIES; attempt++) {
+    if (ssd1306_try_command(ssd, SET_COL_ADDR) &&
+        ssd1306_try_command(ssd, 0) &&
+        ssd1306_try_command(ssd, ssd->width - 1) &&
+        ssd1306_try_command(ssd, SET_PAGE_ADDR) &&
+        ssd1306_try_command(ssd, 0) &&
+        ssd1306_try_command(ssd, ssd->pages - 1) &&
+        ssd1306_write(ssd, frame, ssd->bufsize)) {
+      return;
+    }
+    ssd->i2c_retries++;
+  }
 }
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
@@ -1,3 +1,6 @@
+#ifndef SSD1306_H
+#define SSD1306_H
+
 #include <stdlib.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
@@ -5,6 +8,21 @@
 #define WIDTH 128
 #define HEIGHT 64
 
+// Transporte I2C: velocidades testadas na calibração (em ordem crescente) e tentativas por transação.
+// O SSD1306 é especificado até 400 kHz; acima disso só com SSD1306_I2C_ABOVE_SPEC=1 (por placa,
+// sabendo que uma calibração "aprovada" fora da especificação pode falhar depois).
+#ifndef SSD1306_I2C_ABOVE_SPEC
+#define SSD1306_I2C_ABOVE_SPEC 0
+#endif
+#if SSD1306_I2C_ABOVE_SPEC
+#define SSD1306_I2C_SPEEDS {100000, 200000, 400000, 700000, 1000000}
+#else
+#define SSD1306_I2C_SPEEDS {100000, 200000, 400000}
+#endif
+#define SSD1306_I2C_RETRIES 3
+#define SSD1306_I2C_STEP_UP_AFTER 128   // Escritas sem erro para voltar a subir uma velocidade
+#define SSD1306_CALIBRATION_TRIALS 16
+
 typedef enum {
   SET_CONTRAST = 0x81,
   SET_ENTIRE_ON = 0xA4,
@@ -32,12 +50,20 @@ typedef struct {
   uint8_t *ram_buffer;
   size_t bufsize;
   uint8_t port_buffer[2];
+  uint8_t speed_index;    // Posição atual em SSD1306_I2C_SPEEDS
+  uint8_t speed_max;      // Maior posição confirmada pela calibração (teto da volta)
+  uint16_t clean_writes;  // Escritas sem erro desde a última mudança de velocidade
+  uint32_t baudrate;      // Velocidade efetiva do barramento
+  uint32_t i2c_errors;    // NAKs e timeouts
+  uint32_t i2c_retries;   // Transações repetidas após erro
 } ssd1306_t;
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
 void ssd1306_config(ssd1306_t *ssd);
+uint32_t ssd1306_calibrate(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
 void ssd1306_send_data(ssd1306_t *ssd);
+void ssd1306_send_frame(ssd1306_t *ssd, const uint8_t *frame);
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
@@ -47,4 +73,6 @@ void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
 void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
-void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *bitmap_128x64);
\ No newline at end of file
+void ssd1306_draw_bitmap(ssd1306_t *ssd, const uint8_t *bitmap_128x64);
+
+#endif
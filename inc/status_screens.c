@@ -0,0 +1,11 @@
+#include "status_screens.h"
+
+void status_screen_render(ssd1306_t *ssd, int index) {
+    ssd1306_fill(ssd, false);
+    for (int i = 0; i < 3; i++) {
+        const status_line_t *line = &status_screens[index].lines[i];
+        if (line->text != NULL) {
+            ssd1306_draw_string(ssd, line->text, line->x, line->y);
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef STATUS_SCREENS_H
+#define STATUS_SCREENS_H
+
+#include <stdint.h>
+#include "assets.h"
+#include "ssd1306.h"
+
+// Telas de status (-2 a 6) só com texto fixo. status_screen_render desenha a partir da tabela
+// e é usada pelo gerador de quadros (tools/gen_status_frames.c) e, quando os quadros
+// pré-gerados não estão disponíveis, pelo firmware. Os quadros de referência versionados
+// (tests/fixtures/status_frames) conferem o resultado.
+
+#define STATUS_SCREEN_FIRST -2
+#define STATUS_SCREEN_LAST 6
+#define STATUS_SCREEN_COUNT (STATUS_SCREEN_LAST - STATUS_SCREEN_FIRST + 1)
+
+typedef struct {
+    const char *text;
+    uint8_t x, y;
+} status_line_t;
+
+typedef struct {
+    status_line_t lines[3];     // Linhas sem texto ficam com text == NULL
+} status_screen_t;
+
+static const status_screen_t status_screens[STATUS_SCREEN_COUNT] = {
+    {{{"ERRO", 50, 20}, {"SEM RESPOSTA", 16, 35}}},                    // -2: requisição expirou
+    {{{"PROJETO", 3, 15}, {"FINAL", 3, 30}, {"EMBARCATECH", 3, 45}}},   // -1: abertura
+    {{{"CONECTANDO A", 3, 20}, {WIFI_SSID, 3, 35}}},                    // 0
+    {{{"CONECTADO A", 3, 20}, {WIFI_SSID, 3, 35}}},                     // 1
+    {{{"ERRO", 50, 20}, {"AO CONECTAR", 20, 35}}},                      // 2
+    {{{"ERRO", 50, 20}, {"AO INICIAR", 20, 35}}},                       // 3
+    {{{"REQUISITANDO", 3, 20}, {"DADOS", 30, 35}}},                     // 4
+    {{{"DADOS", 3, 20}, {"RECEBIDOS", 3, 35}}},                         // 5
+    {{{"TRATANDO", 3, 20}, {"DADOS", 3, 35}}},                          // 6
+};
+
+// Função que desenha a tela 'index' (0 = tela STATUS_SCREEN_FIRST) no framebuffer
+void status_screen_render(ssd1306_t *ssd, int index);
+
+#endif
@@ -0,0 +1,37 @@
+#include <assert.h>
+#include "temp_filter.h"
+
+uint32_t temp_filter_moving_average(const uint16_t *samples, uint32_t mask, uint32_t newest, uint32_t r) {
+    uint32_t sum = 0;
+    for (uint32_t i = 0; i < r; i++) {
+        sum += samples[(newest - i) & mask];
+    }
+    return sum;
+}
+
+// CIC (integradores + pentes) rodado sobre as últimas ordem*R amostras a partir de estado zero:
+// a última saída já depende só de amostras do bloco, então é igual ao filtro em regime.
+// A aritmética módulo 2^32 é exata enquanto 12 + ordem*log2(R) bits couberem em 32.
+uint32_t temp_filter_cic(const uint16_t *samples, uint32_t mask, uint32_t newest, uint8_t order, uint32_t r) {
+    assert(order >= 1 && order <= TEMP_FILTER_MAX_ORDER);
+    uint32_t integrator[TEMP_FILTER_MAX_ORDER] = {0}, comb[TEMP_FILTER_MAX_ORDER] = {0};
+    uint32_t out = 0;
+    uint32_t span = order * r;
+
+    for (uint32_t i = 0; i < span; i++) {
+        uint32_t x = samples[(newest - span + 1 + i) & mask];
+        for (uint8_t k = 0; k < order; k++) {
+            integrator[k] += x;
+            x = integrator[k];
+        }
+        if ((i + 1) % r == 0) {
+            for (uint8_t k = 0; k < order; k++) {
+                uint32_t y = x - comb[k];
+                comb[k] = x;
+                x = y;
+            }
+            out = x;
+        }
+    }
+    return out;
+}
@@ -0,0 +1,16 @@
+#ifndef TEMP_FILTER_H
+#define TEMP_FILTER_H
+
+#include <stdint.h>
+
+// Kernels de decimação do sensor de temperatura, sem dependência do hardware (testados no host).
+// Rodam sobre um buffer circular de 2^n amostras; 'mask' = tamanho - 1 e 'newest' é o índice
+// da amostra mais recente.
+
+#define TEMP_FILTER_MAX_ORDER 4             // Tamanho do estado do CIC
+
+// Retornam a soma ponderada com ganho R^ordem (sem dividir, preservando a resolução extra).
+uint32_t temp_filter_moving_average(const uint16_t *samples, uint32_t mask, uint32_t newest, uint32_t r);
+uint32_t temp_filter_cic(const uint16_t *samples, uint32_t mask, uint32_t newest, uint8_t order, uint32_t r);
+
+#endif
@@ -0,0 +1,73 @@
+#include "temp_sensor.h"
+#include "temp_filter.h"
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/clocks.h"
+
+#if TEMP_FILTER_ORDER < 1 || TEMP_FILTER_ORDER > TEMP_FILTER_MAX_ORDER
+#error "TEMP_FILTER_ORDER deve ficar entre 1 e TEMP_FILTER_MAX_ORDER"
+#endif
+#if TEMP_FILTER_ORDER * TEMP_DECIMATION > TEMP_RING_SAMPLES
+#error "O buffer circular precisa guardar TEMP_FILTER_ORDER * TEMP_DECIMATION amostras"
+#endif
+
+// O modo ring do DMA exige o buffer alinhado ao próprio tamanho
+static uint16_t ring[TEMP_RING_SAMPLES] __attribute__((aligned(1u << TEMP_RING_BITS)));
+static int dma_chan = -1;
+
+// Função para iniciar o ADC em modo contínuo com DMA para o buffer circular
+void temp_sensor_init(void) {
+    adc_init();
+    adc_set_temp_sensor_enabled(true);
+    adc_select_input(TEMP_ADC_INPUT);
+    adc_set_round_robin(TEMP_ROUND_ROBIN_MASK);
+    adc_fifo_setup(true, true, 1, false, false); // FIFO com DREQ a cada conversão
+    adc_set_clkdiv(48000000.0f / TEMP_SAMPLE_RATE_HZ - 1);
+
+    dma_chan = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, TEMP_RING_BITS);
+    channel_config_set_dreq(&c, DREQ_ADC);
+    // Contagem máxima: a 1 kHz só termina depois de ~49 dias, e aí é rearmado em temp_sensor_read
+    dma_channel_configure(dma_chan, &c, ring, &adc_hw->fifo, 0xFFFFFFFF, true);
+
+    adc_run(true);
+}
+
+// Função para obter a temperatura filtrada em centésimos de grau
+bool temp_sensor_read(int32_t *centi_celsius) {
+    if (dma_chan < 0) {
+        return false;
+    }
+    uint32_t remaining = dma_hw->ch[dma_chan].transfer_count;
+    if (0xFFFFFFFF - remaining < TEMP_FILTER_ORDER * TEMP_DECIMATION) {
+        return false; // Ainda não há amostras suficientes desde o início
+    }
+    if (!dma_channel_is_busy(dma_chan)) {
+        dma_channel_set_trans_count(dma_chan, 0xFFFFFFFF, true);
+    }
+
+    // Próxima posição de escrita do DMA -> a anterior é a amostra mais recente
+    uint32_t next = (dma_hw->ch[dma_chan].write_addr - (uintptr_t)ring) / sizeof(uint16_t);
+    uint32_t newest = next - 1;
+
+#if TEMP_FILTER_ORDER == 1
+    uint32_t sum = temp_filter_moving_average(ring, TEMP_RING_SAMPLES - 1, newest, TEMP_DECIMATION);
+    uint64_t gain = TEMP_DECIMATION;
+#else
+    uint32_t sum = temp_filter_cic(ring, TEMP_RING_SAMPLES - 1, newest, TEMP_FILTER_ORDER, TEMP_DECIMATION);
+    uint64_t gain = 1;
+    for (uint8_t k = 0; k < TEMP_FILTER_ORDER; k++) {
+        gain *= TEMP_DECIMATION;
+    }
+#endif
+
+    // Datasheet: T = 27 - (V - 0,706) / 0,001721, com V = leitura * 3,3 / 4096
+    int64_t microvolts = (int64_t)sum * 3300000 / (4096 * gain);
+    *centi_celsius = 2700 - (int32_t)((microvolts - 706000) * 100 / 1721);
+    return true;
+}
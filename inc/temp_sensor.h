@@ -0,0 +1,26 @@
+#ifndef TEMP_SENSOR_H
+#define TEMP_SENSOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Amostragem contínua do sensor de temperatura interno do RP2040.
+// O ADC roda livre (round-robin) e o DMA grava cada conversão num buffer circular,
+// sem custo de CPU por amostra; a leitura aplica o filtro de decimação sobre as
+// amostras mais recentes. Mede a temperatura do chip, que fica alguns graus acima
+// do ambiente quando o WiFi está ativo.
+
+#define TEMP_ADC_INPUT 4                    // Canal interno do sensor de temperatura
+#define TEMP_ROUND_ROBIN_MASK (1u << TEMP_ADC_INPUT)
+#define TEMP_SAMPLE_RATE_HZ 1000
+#define TEMP_RING_BITS 9                    // Buffer de 2^9 bytes = 256 amostras
+#define TEMP_RING_SAMPLES (1u << (TEMP_RING_BITS - 1))
+
+// Filtro: ordem 1 = média móvel de R amostras; ordem 2 = CIC de 2ª ordem (resposta triangular)
+#define TEMP_FILTER_ORDER 2                 // Até TEMP_FILTER_MAX_ORDER (inc/temp_filter.h)
+#define TEMP_DECIMATION 64                  // R: amostras combinadas em cada saída
+
+void temp_sensor_init(void);
+bool temp_sensor_read(int32_t *centi_celsius);
+
+#endif
@@ -19,7 +19,9 @@
 #define MEM_LIBC_MALLOC             0
 #endif
 #define MEM_ALIGNMENT               4
-#define MEM_SIZE                    4000
+// 4000 bytes para os pbufs de envio + ~3 KB da raiz do TLS (parse do DER, RSA 4096), que fica
+// no heap do lwIP; confira com o relatório de memória ("lwIP heap ... max")
+#define MEM_SIZE                    7000
 #define MEMP_NUM_TCP_SEG            32
 #define MEMP_NUM_ARP_QUEUE          10
 #define PBUF_POOL_SIZE              24
@@ -35,9 +37,12 @@
 #define LWIP_NETIF_LINK_CALLBACK    1
 #define LWIP_NETIF_HOSTNAME         1
 #define LWIP_NETCONN                0
-#define MEM_STATS                   0
+// Estatísticas de mem/memp sempre ativas -> marcas d'água no relatório de memória (inc/mem_report.c)
+#define LWIP_STATS                  1
+#define LWIP_STATS_DISPLAY          1
+#define MEM_STATS                   1
 #define SYS_STATS                   0
-#define MEMP_STATS                  0
+#define MEMP_STATS                  1
 #define LINK_STATS                  0
 // #define ETH_PAD_SIZE                2
 #define LWIP_CHKSUM_ALGORITHM       3
@@ -51,10 +56,15 @@
 #define DHCP_DOES_ARP_CHECK         0
 #define LWIP_DHCP_DOES_ACD_CHECK    0
 
+// Camada altcp para HTTPS (mbedTLS via altcp_tls)
+#define LWIP_ALTCP                  1
+#define LWIP_ALTCP_TLS              1
+#define LWIP_ALTCP_TLS_MBEDTLS      1
+// Sem certificado válido o handshake falha (o padrão do lwIP é VERIFY_OPTIONAL, que aceita qualquer um)
+#define ALTCP_MBEDTLS_AUTHMODE      MBEDTLS_SSL_VERIFY_REQUIRED
+
 #ifndef NDEBUG
 #define LWIP_DEBUG                  1
-#define LWIP_STATS                  1
-#define LWIP_STATS_DISPLAY          1
 #endif
 
 #define ETHARP_DEBUG                LWIP_DBG_OFF
@@ -85,5 +95,6 @@
 #define PPP_DEBUG                   LWIP_DBG_OFF
 #define SLIP_DEBUG                  LWIP_DBG_OFF
 #define DHCP_DEBUG                  LWIP_DBG_OFF
+#define ALTCP_MBEDTLS_DEBUG         LWIP_DBG_OFF
 
 #endif /* __LWIPOPTS_H__ */
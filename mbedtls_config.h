@@ -0,0 +1,95 @@
+#ifndef __MBEDTLS_CONFIG_H__
+#define __MBEDTLS_CONFIG_H__
+
+// Configuração mínima do mbedTLS para o cliente HTTPS (altcp_tls)
+// Apenas TLS 1.2 cliente, com suítes escolhidas pelo custo no Cortex-M0+ (sem AES em hardware)
+
+// Alguns fontes do mbedtls usam INT_MAX sem incluir limits.h
+#include <limits.h>
+
+// Entropia vem do ROSC via pico_mbedtls
+#define MBEDTLS_NO_PLATFORM_ENTROPY
+#define MBEDTLS_ENTROPY_HARDWARE_ALT
+
+#define MBEDTLS_HAVE_TIME
+#define MBEDTLS_PLATFORM_MS_TIME_ALT
+
+// Buffers de registro: a entrada precisa aceitar um registro TLS completo,
+// a saída só carrega a requisição GET
+#define MBEDTLS_SSL_IN_CONTENT_LEN      16384
+#define MBEDTLS_SSL_OUT_CONTENT_LEN     2048
+
+// Protocolo e extensões
+#define MBEDTLS_SSL_TLS_C
+#define MBEDTLS_SSL_CLI_C
+#define MBEDTLS_SSL_PROTO_TLS1_2
+#define MBEDTLS_SSL_SERVER_NAME_INDICATION
+#define MBEDTLS_SSL_EXTENDED_MASTER_SECRET
+#define MBEDTLS_SSL_MAX_FRAGMENT_LENGTH
+#define MBEDTLS_SSL_SESSION_TICKETS     // Retomada por ticket (RFC 5077), além do session ID
+
+// Troca de chaves: somente ECDHE (o servidor da API usa certificado RSA)
+#define MBEDTLS_KEY_EXCHANGE_ECDHE_RSA_ENABLED
+#define MBEDTLS_KEY_EXCHANGE_ECDHE_ECDSA_ENABLED
+
+// Curvas: X25519 e P-256 com redução rápida; janelas pequenas para economizar RAM
+#define MBEDTLS_ECP_DP_CURVE25519_ENABLED
+#define MBEDTLS_ECP_DP_SECP256R1_ENABLED
+#define MBEDTLS_ECP_DP_SECP384R1_ENABLED
+#define MBEDTLS_ECP_NIST_OPTIM
+#define MBEDTLS_ECP_WINDOW_SIZE         2
+#define MBEDTLS_ECP_FIXED_POINT_OPTIM   0
+#define MBEDTLS_MPI_WINDOW_SIZE         1
+
+// Suítes em ordem de preferência: ChaCha20-Poly1305 é mais rápido que AES-GCM
+// em software no M0+; AES-128-GCM fica como alternativa
+#define MBEDTLS_SSL_CIPHERSUITES \
+    MBEDTLS_TLS_ECDHE_RSA_WITH_CHACHA20_POLY1305_SHA256, \
+    MBEDTLS_TLS_ECDHE_ECDSA_WITH_CHACHA20_POLY1305_SHA256, \
+    MBEDTLS_TLS_ECDHE_RSA_WITH_AES_128_GCM_SHA256, \
+    MBEDTLS_TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256
+
+// Primitivas usadas pelas suítes acima
+#define MBEDTLS_CHACHA20_C
+#define MBEDTLS_POLY1305_C
+#define MBEDTLS_CHACHAPOLY_C
+#define MBEDTLS_AES_C
+#define MBEDTLS_AES_FEWER_TABLES
+#define MBEDTLS_GCM_C
+#define MBEDTLS_CIPHER_C
+#define MBEDTLS_MD_C
+#define MBEDTLS_SHA224_C
+#define MBEDTLS_SHA256_C
+#define MBEDTLS_SHA384_C
+#define MBEDTLS_SHA512_C
+#define MBEDTLS_BIGNUM_C
+#define MBEDTLS_ECP_C
+#define MBEDTLS_ECDH_C
+#define MBEDTLS_ECDSA_C
+#define MBEDTLS_RSA_C
+#define MBEDTLS_PKCS1_V15
+#define MBEDTLS_PKCS1_V21
+#define MBEDTLS_CTR_DRBG_C
+#define MBEDTLS_ENTROPY_C
+
+// Certificados do servidor
+#define MBEDTLS_X509_USE_C
+#define MBEDTLS_X509_CRT_PARSE_C
+#define MBEDTLS_PK_C
+#define MBEDTLS_PK_PARSE_C
+#define MBEDTLS_ASN1_PARSE_C
+#define MBEDTLS_ASN1_WRITE_C
+#define MBEDTLS_OID_C
+#define MBEDTLS_BASE64_C
+#define MBEDTLS_PEM_PARSE_C
+
+#define MBEDTLS_PLATFORM_C
+#define MBEDTLS_ERROR_C
+
+// Alocações do mbedTLS saem de uma arena estática (mbedtls_memory_buffer_alloc_init)
+// em vez do heap; MEMORY_DEBUG mantém o pico de uso para o relatório de memória
+#define MBEDTLS_PLATFORM_MEMORY
+#define MBEDTLS_MEMORY_BUFFER_ALLOC_C
+#define MBEDTLS_MEMORY_DEBUG
+
+#endif /* __MBEDTLS_CONFIG_H__ */
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+# Gera os corpos comprimidos usados por tests/test_http_body.c a partir dos JSON gravados.
+# Rodar de novo só quando weather.json/forecast.json mudarem; a saída é versionada.
+import gzip
+import io
+import os
+import random
+import zlib
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+
+def write(name, data):
+    with open(os.path.join(HERE, name), "wb") as f:
+        f.write(data)
+
+
+def gzip_named(data, name):
+    # Cabeçalho com FNAME, como alguns servidores mandam
+    buf = io.BytesIO()
+    with gzip.GzipFile(filename=name, mode="wb", fileobj=buf, mtime=0) as f:
+        f.write(data)
+    return buf.getvalue()
+
+
+def raw_deflate(data):
+    c = zlib.compressobj(9, zlib.DEFLATED, -15)
+    return c.compress(data) + c.flush()
+
+
+for base in ("weather", "forecast"):
+    data = open(os.path.join(HERE, base + ".json"), "rb").read()
+    write(base + ".json.gz", gzip_named(data, base + ".json"))
+    write(base + ".json.zz", zlib.compress(data, 9))
+    write(base + ".json.deflate", raw_deflate(data))
+
+# Bloco aleatório repetido a 5000 bytes de distância: exige janela maior que 4 KB
+rng = random.Random(1)
+block = bytes(rng.choice(b"abcdefghijklmnopqrstuvwxyz0123456789") for _ in range(5000))
+write("far_reference.txt", block * 2)
+write("far_reference.txt.gz", gzip.compress(block * 2, 9, mtime=0))
+
+
+# Traços de bordas dos botões para tests/test_input.c: "tempo_us gpio nível" por linha, nível 0 =
+# pressionado (pull-up). A trepidação segue o perfil de uma chave táctil: rajadas de 5 a 13
+# bordas com intervalos de 20 a 400 µs, durando até ~2 ms, no aperto e na soltura.
+def bounce(rng, t, gpio, level):
+    edges = []
+    n = rng.randrange(2, 7) * 2 + 1   # Ímpar: termina no nível final
+    for _ in range(n):
+        edges.append((t, gpio, level))
+        t += rng.randrange(20, 400)
+        level ^= 1
+    return edges, t
+
+
+def press(rng, t, gpio, hold_us):
+    down, t = bounce(rng, t, gpio, 0)
+    up, _ = bounce(rng, t + hold_us, gpio, 1)
+    return down + up
+
+
+def write_trace(name, comment, edges):
+    lines = ["# " + comment] + ["%d %d %d" % e for e in sorted(edges)]
+    write(name, ("\n".join(lines) + "\n").encode())
+
+
+rng = random.Random(2)
+edges = []
+edges += press(rng, 1000000, 5, 150000)            # Toque curto no A
+edges += [(1500000, 5, 0), (1500300, 5, 1)]         # Espúrio de 300 µs: ignorado
+edges += press(rng, 2000000, 5, 60000)             # Dois toques rápidos no A
+edges += press(rng, 2120000, 5, 60000)
+edges += press(rng, 3000000, 6, 400000)            # A e B sobrepostos
+edges += press(rng, 3100000, 5, 100000)
+edges += press(rng, 4000000, 22, 1500000)          # Joystick segurado 1,5 s
+write_trace("bounce_presses.trace", "toques com trepidação, espúrio e botões sobrepostos", edges)
+
+# Botão segurado atravessando 2^32 µs (~71,6 min), onde time_us_32()/1000 voltava a zero
+rng = random.Random(3)
+wrap = 1 << 32
+edges = press(rng, wrap - 500000, 6, 2100000)
+edges += press(rng, wrap + 2500000, 5, 50000)
+write_trace("bounce_wrap.trace", "segurado atravessando a volta de 32 bits dos µs", edges)
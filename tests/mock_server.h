@@ -0,0 +1,35 @@
+// Servidor HTTP simulado dos testes de host: monta respostas completas (cabeçalhos, corpo
+// com Content-Length ou chunked) para alimentar o decodificador como se viessem da rede.
+#ifndef MOCK_SERVER_H
+#define MOCK_SERVER_H
+
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+// Monta a resposta completa em 'wire' (chunk == 0 -> Content-Length)
+static inline size_t mock_response(uint8_t *wire, size_t size, int status, const char *encoding,
+                                   size_t chunk, const uint8_t *body, size_t body_len) {
+    size_t n = (size_t)snprintf((char *)wire, size, "HTTP/1.1 %d %s\r\nContent-Type: application/json\r\n",
+                                status, status == 200 ? "OK" : "Unauthorized");
+    if (encoding != NULL) {
+        n += (size_t)snprintf((char *)wire + n, size - n, "Content-Encoding: %s\r\n", encoding);
+    }
+    if (chunk == 0) {
+        n += (size_t)snprintf((char *)wire + n, size - n, "Content-Length: %zu\r\n\r\n", body_len);
+        memcpy(wire + n, body, body_len);
+        return n + body_len;
+    }
+    n += (size_t)snprintf((char *)wire + n, size - n, "Transfer-Encoding: chunked\r\n\r\n");
+    for (size_t pos = 0; pos < body_len; pos += chunk) {
+        size_t len = body_len - pos < chunk ? body_len - pos : chunk;
+        n += (size_t)snprintf((char *)wire + n, size - n, "%zx\r\n", len);
+        memcpy(wire + n, body + pos, len);
+        n += len;
+        n += (size_t)snprintf((char *)wire + n, size - n, "\r\n");
+    }
+    n += (size_t)snprintf((char *)wire + n, size - n, "0\r\n\r\n");
+    return n;
+}
+
+#endif
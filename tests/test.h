@@ -0,0 +1,76 @@
+// Utilitários mínimos dos testes de host: checagens sem abortar, leitura de fixtures e
+// contador de ciclos para os números de desempenho impressos pelos testes.
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+static int test_failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        fprintf(stderr, "%s:%d: falhou: %s\n", __FILE__, __LINE__, #cond); \
+        test_failures++; \
+    } \
+} while (0)
+
+#define CHECK_EQ(a, b) do { \
+    long long a_ = (long long)(a), b_ = (long long)(b); \
+    if (a_ != b_) { \
+        fprintf(stderr, "%s:%d: falhou: %s == %s (%lld != %lld)\n", __FILE__, __LINE__, #a, #b, a_, b_); \
+        test_failures++; \
+    } \
+} while (0)
+
+// Resultado final do executável (usado pelo ctest)
+static inline int test_report(const char *name) {
+    if (test_failures) {
+        fprintf(stderr, "%s: %d falha(s)\n", name, test_failures);
+        return 1;
+    }
+    printf("%s: ok\n", name);
+    return 0;
+}
+
+// Lê um arquivo inteiro de 'dir'; aborta o teste se não existir
+static inline uint8_t *test_load(const char *dir, const char *name, size_t *len) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        perror(path);
+        exit(1);
+    }
+    fseek(f, 0, SEEK_END);
+    *len = (size_t)ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t *data = malloc(*len + 1);
+    if (fread(data, 1, *len, f) != *len) {
+        perror(path);
+        exit(1);
+    }
+    data[*len] = '\0';
+    fclose(f);
+    return data;
+}
+
+// Ciclos da CPU do host (TSC no x86); nas outras arquiteturas, nanossegundos
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TEST_CYCLES_UNIT "ciclos"
+static inline uint64_t test_cycles(void) {
+    return __rdtsc();
+}
+#else
+#define TEST_CYCLES_UNIT "ns"
+static inline uint64_t test_cycles(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+#endif
+
+#endif
@@ -0,0 +1,210 @@
+// Testes da previsão (inc/forecast.c) com as respostas gravadas em tests/fixtures: valores
+// interpolados contra os pontos da previsão, correção pela observação (que chega antes da
+// previsão e minutos antes do primeiro ponto), previsão anterior mantida quando a nova falha e
+// as requisições de um dia com a política de atualização do firmware.
+#include <math.h>
+#include <string.h>
+#include "test.h"
+#include "inc/forecast.h"
+
+#define INTERPOLATION_S 10              // INTERPOLATION_MS de WeatherAssistant.c
+#define FORECAST_RETRY_S (5 * 60)       // FORECAST_RETRY_MS de WeatherAssistant.c
+#define STEP_S (3 * 3600)
+#define DAYS 7
+
+static const char *fixtures;
+static uint8_t *forecast_json;
+static size_t forecast_len;
+static forecast_point_t recorded[FORECAST_MAX_POINTS];
+
+// Entrega o corpo em pedaços de 'split' bytes, como o http_body faz com os pbufs
+static void feed(const uint8_t *data, size_t len, size_t split) {
+    forecast_begin();
+    for (size_t pos = 0; pos < len; pos += split) {
+        forecast_sink(NULL, data + pos, len - pos < split ? len - pos : split);
+    }
+}
+
+// Lê "campo":valor a partir de 'from' (valores em centésimos, como no firmware)
+static const char *read_number(const char *from, const char *key, double *value) {
+    char pattern[32];
+    snprintf(pattern, sizeof(pattern), "\"%s\":", key);
+    const char *at = strstr(from, pattern);
+    if (at == NULL) {
+        fprintf(stderr, "campo %s não encontrado\n", key);
+        exit(1);
+    }
+    *value = strtod(at + strlen(pattern), NULL);
+    return at + strlen(pattern);
+}
+
+static int32_t centi(double value) {
+    return (int32_t)(value * 100 + (value < 0 ? -0.5 : 0.5));
+}
+
+static void load_recorded(void) {
+    forecast_json = test_load(fixtures, "forecast.json", &forecast_len);
+    const char *at = (const char *)forecast_json;
+    for (int i = 0; i < FORECAST_MAX_POINTS; i++) {
+        double dt, temp, feels;
+        at = read_number(at, "dt", &dt);
+        at = read_number(at, "temp", &temp);
+        at = read_number(at, "feels_like", &feels);
+        recorded[i] = (forecast_point_t){(uint32_t)dt, (int16_t)centi(temp), (int16_t)centi(feels)};
+    }
+}
+
+// Temperatura gravada interpolada em ponto flutuante (até um intervalo antes, o primeiro ponto)
+static double recorded_line(uint32_t at) {
+    if (at < recorded[0].dt) {
+        return recorded[0].temp;
+    }
+    int i = (at - recorded[0].dt) / STEP_S;
+    return recorded[i].temp + (double)(recorded[i + 1].temp - recorded[i].temp) * (at - recorded[i].dt) / STEP_S;
+}
+
+// Sem observação: nos pontos os valores gravados, entre eles a reta, antes deles o primeiro
+// ponto (até um intervalo) e depois do último nada
+static void test_interpolation(void) {
+    static const size_t splits[] = {1, 7, 536, 4096};
+    for (size_t s = 0; s < sizeof(splits) / sizeof(splits[0]); s++) {
+        feed(forecast_json, forecast_len, splits[s]);
+        CHECK(forecast_commit());
+        CHECK_EQ(forecast_count(), FORECAST_MAX_POINTS);
+    }
+
+    int32_t temp, feels;
+    for (int i = 0; i < FORECAST_MAX_POINTS; i++) {
+        CHECK(forecast_estimate(recorded[i].dt, &temp, &feels));
+        CHECK_EQ(temp, recorded[i].temp);
+        CHECK_EQ(feels, recorded[i].feels_like);
+    }
+    int32_t worst = 0;
+    for (int i = 0; i + 1 < FORECAST_MAX_POINTS; i++) {
+        for (uint32_t t = 0; t < STEP_S; t += 600) {
+            CHECK(forecast_estimate(recorded[i].dt + t, &temp, &feels));
+            int32_t error = (int32_t)(temp - recorded_line(recorded[i].dt + t));
+            error = error < 0 ? -error : error;
+            worst = error > worst ? error : worst;
+        }
+    }
+    CHECK(worst <= 1);  // Truncamento do Q16: no máximo 0,01 °C
+    CHECK(forecast_estimate(recorded[0].dt - 3600, &temp, &feels));
+    CHECK_EQ(temp, recorded[0].temp);
+    CHECK(!forecast_estimate(recorded[0].dt - STEP_S - 1, &temp, &feels));
+    CHECK(!forecast_estimate(recorded[FORECAST_MAX_POINTS - 1].dt + 1, &temp, &feels));
+}
+
+// A observação (weather.json) é de 3 minutos antes do primeiro ponto e chega antes da previsão:
+// no instante dela vale o valor observado, e a correção some em FORECAST_BLEND_S
+static void test_observation(void) {
+    size_t len;
+    char *weather = (char *)test_load(fixtures, "weather.json", &len);
+    double dt, temp, feels;
+    read_number(weather, "temp", &temp);
+    read_number(weather, "feels_like", &feels);
+    read_number(weather, "dt", &dt);
+    free(weather);
+    uint32_t observed = (uint32_t)dt;
+    CHECK(observed < recorded[0].dt);
+
+    for (int order = 0; order < 2; order++) {
+        forecast_observe(observed, centi(temp), centi(feels));
+        if (order == 0) {   // Ordem do firmware: observação, depois a previsão
+            feed(forecast_json, forecast_len, 536);
+            CHECK(forecast_commit());
+        }
+        int32_t t, f;
+        CHECK(forecast_estimate(observed, &t, &f));
+        CHECK_EQ(t, centi(temp));
+        CHECK_EQ(f, centi(feels));
+
+        // Metade do tempo de correção: metade da diferença; depois dele, a previsão pura
+        int32_t offset = centi(temp) - recorded[0].temp;
+        uint32_t half = observed + FORECAST_BLEND_S / 2, end = observed + FORECAST_BLEND_S;
+        CHECK(forecast_estimate(half, &t, &f));
+        CHECK(fabs(t - (recorded_line(half) + offset / 2.0)) <= 1);
+        CHECK(forecast_estimate(end, &t, &f));
+        CHECK(fabs(t - recorded_line(end)) <= 1);
+    }
+}
+
+// Atualização que falha no meio (conexão caída, resposta cortada, erro da API): a previsão
+// em uso não muda
+static void test_failed_refresh(void) {
+    int32_t before_t, before_f, t, f;
+    uint32_t probe = recorded[3].dt + 1234;
+    CHECK(forecast_estimate(probe, &before_t, &before_f));
+
+    feed(forecast_json, forecast_len / 2, 97);  // Metade da lista e a conexão fecha
+    CHECK(!forecast_commit());
+    feed(forecast_json, forecast_len / 2, 97);  // Metade e erro/timeout: nem chega ao commit
+    static const char error_body[] = "{\"cod\":429,\"message\":\"limite excedido\"}";
+    feed((const uint8_t *)error_body, strlen(error_body), 5);
+    CHECK(!forecast_commit());
+
+    CHECK_EQ(forecast_count(), FORECAST_MAX_POINTS);
+    CHECK(forecast_estimate(probe, &t, &f));
+    CHECK_EQ(t, before_t);
+    CHECK_EQ(f, before_f);
+}
+
+// Resposta do /forecast no instante 'now': os pontos gravados deslocados para começar no próximo
+// horário múltiplo de 3 h, como a API faz
+static size_t serve_forecast(uint32_t now, char *out, size_t size) {
+    uint32_t first = (now / STEP_S + 1) * STEP_S;
+    size_t n = snprintf(out, size, "{\"cod\":\"200\",\"message\":0,\"cnt\":%d,\"list\":[", FORECAST_MAX_POINTS);
+    for (int i = 0; i < FORECAST_MAX_POINTS; i++) {
+        n += snprintf(out + n, size - n, "%s{\"dt\":%u,\"main\":{\"temp\":%d.%02d,\"feels_like\":%d.%02d},\"weather\":[{\"id\":803}]}",
+                      i ? "," : "", (unsigned)(first + i * STEP_S), recorded[i].temp / 100, recorded[i].temp % 100,
+                      recorded[i].feels_like / 100, recorded[i].feels_like % 100);
+    }
+    n += snprintf(out + n, size - n, "]}");
+    return n;
+}
+
+// Uma semana com a política do firmware: observação no início, previsão quando a atual está
+// acabando (uma tentativa a cada FORECAST_RETRY_S) e uma atualização local a cada 10 s.
+// Uma em cada três respostas da previsão chega cortada, e a tela nunca deve ficar sem valor.
+static void test_requests_per_day(void) {
+    static char body[4096];
+    uint32_t start = recorded[0].dt + 7 * 3600 + 123;
+    uint32_t last_attempt = 0;
+    unsigned requests = 1, forecasts = 0, updates = 0, uncovered = 0;   // 1 = observação inicial
+    forecast_observe(start, recorded[2].temp + 150, recorded[2].feels_like + 150);
+
+    for (uint32_t now = start; now < start + DAYS * 86400; now += INTERPOLATION_S) {
+        int32_t t, f;
+        if (forecast_estimate(now, &t, &f)) {
+            updates++;
+        } else {
+            uncovered++;
+        }
+        if (forecast_needs_refresh(now) && (last_attempt == 0 || now - last_attempt >= FORECAST_RETRY_S)) {
+            last_attempt = now;
+            requests++;
+            size_t len = serve_forecast(now, body, sizeof(body));
+            feed((const uint8_t *)body, ++forecasts % 3 == 0 ? len * 2 / 3 : len, 1460);
+            forecast_commit();
+        }
+    }
+    // A primeira previsão vem junto com a observação; a partir daí a tela sempre tem valor
+    CHECK(uncovered <= 1);
+    double per_day = (double)requests / DAYS;
+    printf("requisições por dia: %.1f (observação + previsões, 1/3 delas cortadas), %.0f atualizações locais\n",
+           per_day, (double)updates / DAYS);
+    printf("economia por dia: %.0f contra /weather a cada 10 min, %.0f contra uma requisição por atualização\n",
+           24 * 6 - per_day, (double)updates / DAYS - per_day);
+    CHECK(per_day < 3);
+}
+
+int main(int argc, char **argv) {
+    fixtures = argc > 1 ? argv[1] : "fixtures";
+    load_recorded();
+    test_interpolation();
+    test_observation();
+    test_failed_refresh();
+    test_requests_per_day();
+    free(forecast_json);
+    return test_report("forecast");
+}
@@ -0,0 +1,156 @@
+// Testes do decodificador da resposta (inc/http_body.c + inc/inflate.c) com os corpos gravados
+// em tests/fixtures, comprimidos pelo zlib (make_fixtures.py). Um servidor simulado monta a
+// resposta HTTP (Content-Length ou chunked) e a entrega em pedaços de tamanhos variados, como
+// os pbufs de uma cadeia chegam no callback de recepção.
+#include <string.h>
+#include "test.h"
+#include "inc/http_body.h"
+#include "mock_server.h"
+
+static const char *fixtures;
+
+// Saída do sink acumulada para comparar com o JSON original
+static uint8_t out[16384];
+static size_t out_len;
+
+static void collect(void *ctx, const uint8_t *data, size_t len) {
+    if (out_len + len <= sizeof(out)) {
+        memcpy(out + out_len, data, len);
+    }
+    out_len += len;
+}
+
+// Entrega a resposta em pedaços de 'split' bytes (0 = tamanhos pseudoaleatórios de 1 a 1460).
+// Como no callback de recepção, continua alimentando depois do fim e só para em erro.
+static http_body_status_t deliver(http_body_t *body, const uint8_t *wire, size_t len, size_t split, unsigned seed) {
+    http_body_status_t status = HTTP_BODY_OK;
+    size_t pos = 0;
+    while (pos < len && status != HTTP_BODY_ERROR) {
+        size_t n = split;
+        if (n == 0) {
+            seed = seed * 1103515245u + 12345u;
+            n = 1 + (seed >> 16) % 1460;
+        }
+        if (n > len - pos) {
+            n = len - pos;
+        }
+        status = http_body_feed(body, wire + pos, n);
+        pos += n;
+    }
+    return status;
+}
+
+typedef struct {
+    const char *suffix;     // Arquivo do corpo comprimido ("" = sem compressão)
+    const char *encoding;   // Cabeçalho Content-Encoding
+} variant_t;
+
+static const variant_t variants[] = {
+    {"", NULL},
+    {".gz", "gzip"},
+    {".zz", "deflate"},
+    {".deflate", "deflate"},    // "deflate" sem envelope zlib
+};
+
+static void test_round_trips(const char *name) {
+    static uint8_t wire[32768];
+    static const size_t chunks[] = {0, 64, 1000};
+    static const size_t splits[] = {1, 3, 97, 536, 1460, 0};
+    size_t plain_len;
+    uint8_t *plain = test_load(fixtures, name, &plain_len);
+
+    for (size_t v = 0; v < sizeof(variants) / sizeof(variants[0]); v++) {
+        char file[64];
+        snprintf(file, sizeof(file), "%s%s", name, variants[v].suffix);
+        size_t body_len;
+        uint8_t *body_data = test_load(fixtures, file, &body_len);
+
+        for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++) {
+            size_t wire_len = mock_response(wire, sizeof(wire), 200, variants[v].encoding, chunks[c], body_data, body_len);
+            for (size_t s = 0; s < sizeof(splits) / sizeof(splits[0]); s++) {
+                http_body_t body;
+                out_len = 0;
+                http_body_init(&body, collect, NULL);
+                http_body_status_t status = deliver(&body, wire, wire_len, splits[s], (unsigned)(v * 31 + c * 7 + s));
+
+                // Sem chunked e sem compressão o fim só é conhecido quando a conexão fecha
+                bool ends = chunks[c] != 0 || variants[v].encoding != NULL;
+                if (out_len != plain_len || memcmp(out, plain, plain_len) != 0 ||
+                    status != (ends ? HTTP_BODY_DONE : HTTP_BODY_OK)) {
+                    fprintf(stderr, "%s: chunk %zu, pedaços de %zu: status %d, %zu de %zu bytes\n",
+                            file, chunks[c], splits[s], status, out_len, plain_len);
+                    test_failures++;
+                }
+                CHECK_EQ(body.status, 200);
+                CHECK_EQ(body.wire_bytes, wire_len);
+                CHECK_EQ(body.body_bytes, plain_len);
+            }
+        }
+        free(body_data);
+    }
+    free(plain);
+}
+
+// Referência a 5000 bytes não cabe na janela de 4 KB -> erro (o firmware repete sem compressão)
+static void test_window_limit(void) {
+    static uint8_t wire[32768];
+    size_t body_len;
+    uint8_t *body_data = test_load(fixtures, "far_reference.txt.gz", &body_len);
+    size_t wire_len = mock_response(wire, sizeof(wire), 200, "gzip", 0, body_data, body_len);
+    http_body_t body;
+    out_len = 0;
+    http_body_init(&body, collect, NULL);
+    CHECK_EQ(deliver(&body, wire, wire_len, 536, 0), HTTP_BODY_ERROR);
+    CHECK(out_len >= INFLATE_WINDOW_SIZE);  // Tudo antes da primeira referência distante saiu certo
+    free(body_data);
+}
+
+// Respostas de erro da API chegam com corpo JSON; o status permite descartá-las
+static void test_status(void) {
+    static const char error_body[] = "{\"cod\":401,\"message\":\"Invalid API key.\"}";
+    uint8_t wire[256];
+    size_t wire_len = mock_response(wire, sizeof(wire), 401, NULL, 0, (const uint8_t *)error_body, strlen(error_body));
+    http_body_t body;
+    out_len = 0;
+    http_body_init(&body, collect, NULL);
+    deliver(&body, wire, wire_len, 7, 0);
+    CHECK_EQ(body.status, 401);
+}
+
+// Bytes na rede e custo de decodificação por byte recebido, com e sem compressão
+static void report(const char *name) {
+    static uint8_t wire[32768];
+    const int runs = 200;
+    for (size_t v = 0; v < 2; v++) {
+        char file[64];
+        snprintf(file, sizeof(file), "%s%s", name, variants[v].suffix);
+        size_t body_len;
+        uint8_t *body_data = test_load(fixtures, file, &body_len);
+        size_t wire_len = mock_response(wire, sizeof(wire), 200, variants[v].encoding, 1000, body_data, body_len);
+
+        uint64_t best = UINT64_MAX;
+        for (int r = 0; r < runs; r++) {
+            http_body_t body;
+            out_len = 0;
+            http_body_init(&body, collect, NULL);
+            uint64_t start = test_cycles();
+            deliver(&body, wire, wire_len, 1460, 0);
+            uint64_t spent = test_cycles() - start;
+            best = spent < best ? spent : best;
+        }
+        printf("%-22s %5zu bytes na rede, %5zu decodificados, %.1f %s/byte\n",
+               file, wire_len, out_len, (double)best / wire_len, TEST_CYCLES_UNIT);
+        free(body_data);
+    }
+}
+
+int main(int argc, char **argv) {
+    fixtures = argc > 1 ? argv[1] : "fixtures";
+    test_round_trips("weather.json");
+    test_round_trips("forecast.json");
+    test_window_limit();
+    test_status();
+    report("weather.json");
+    report("forecast.json");
+    return test_report("http_body");
+}
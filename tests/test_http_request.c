@@ -0,0 +1,412 @@
+// Testes do gerenciador de requisições (inc/http_request.c) sobre o altcp simulado
+// (tools/host/lwip/altcp.c) e um relógio simulado. Um servidor lento responde com as fixtures
+// em segmentos espaçados enquanto disparos chegam em rajada; confere que nunca há mais de uma
+// conexão, que os pbufs e o heap não crescem e que cada prazo aborta a conexão a tempo.
+#include <string.h>
+#include <malloc.h>
+#include "test.h"
+#include "mock_server.h"
+#include "lwipopts.h"
+#include "inc/http_request.h"
+#include "inc/http_body.h"
+
+#define STEP_MS 10                  // Passo do relógio simulado
+#define TCP_TICK_MS 500             // Ciclo lento do TCP, que roda o poll
+#define POLL_MS (HTTP_POLL_INTERVAL * TCP_TICK_MS)
+
+uint64_t host_time_us;
+
+static const char *fixtures;
+
+// ----- Servidor simulado -----
+
+typedef enum {
+    SERVER_NORMAL,
+    SERVER_NO_ACCEPT,   // Nunca completa a conexão
+    SERVER_SILENT,      // Conecta e nunca responde
+    SERVER_STALL,       // Para depois do primeiro segmento
+    SERVER_RESET,       // Derruba a conexão (RST) no handshake
+    SERVER_GARBAGE      // Resposta que o decodificador recusa (referência fora da janela)
+} behavior_t;
+
+typedef struct {
+    uint8_t data[16384];
+    size_t len, plain_len;
+} wire_t;
+
+static wire_t weather_wire, forecast_wire, garbage_wire;
+
+static struct {
+    uint32_t connect_ms, ttfb_ms, segment_ms;   // Atrasos do servidor lento
+    size_t segment;                             // Bytes por segmento
+    behavior_t (*plan)(uint32_t connection);    // Comportamento de cada conexão nova
+} server_config;
+
+typedef struct {
+    uint32_t id;            // Conexão atendida (0 = nenhuma)
+    const wire_t *wire;
+    size_t pos;
+    bool connected;
+    behavior_t behavior;
+    uint64_t next_us;       // Próximo evento do servidor
+    uint64_t connected_us;
+} server_t;
+
+static server_t server;
+
+static behavior_t plan_normal(uint32_t connection) {
+    return SERVER_NORMAL;
+}
+
+static behavior_t fixed_behavior;
+
+static behavior_t plan_fixed(uint32_t connection) {
+    return fixed_behavior;
+}
+
+static request_kind_t opened_kind;
+
+static void server_step(void) {
+    struct altcp_pcb *conn = altcp_fake_active();
+    if (conn == NULL) {
+        server.id = 0;
+        return;
+    }
+    if (conn->id != server.id) {
+        server = (server_t){.id = conn->id, .behavior = server_config.plan(conn->id)};
+        server.wire = server.behavior == SERVER_GARBAGE ? &garbage_wire :
+                      opened_kind == REQUEST_FORECAST ? &forecast_wire : &weather_wire;
+        server.next_us = host_time_us + server_config.connect_ms * 1000ull;
+        return;
+    }
+    if (host_time_us < server.next_us) {
+        return;
+    }
+    if (!server.connected) {
+        if (server.behavior == SERVER_NO_ACCEPT) {
+            server.next_us = UINT64_MAX;
+        } else if (server.behavior == SERVER_RESET) {
+            altcp_fake_error(conn, ERR_RST);
+        } else {
+            server.connected = true;
+            server.connected_us = host_time_us;
+            server.next_us = host_time_us + server_config.ttfb_ms * 1000ull;
+            altcp_fake_connect_done(conn);
+        }
+        return;
+    }
+    size_t n = server.wire->len - server.pos;
+    n = n > server_config.segment ? server_config.segment : n;
+    if (server.behavior == SERVER_SILENT || (server.behavior == SERVER_STALL && server.pos > 0)) {
+        server.next_us = UINT64_MAX;
+    } else if (n > 0) {
+        server.pos += n;
+        server.next_us = host_time_us + server_config.segment_ms * 1000ull;
+        altcp_fake_deliver(conn, server.wire->data + server.pos - n, n, TCP_MSS);
+    } else {
+        server.next_us = UINT64_MAX;
+        altcp_fake_remote_close(conn);
+    }
+}
+
+// Avança o relógio rodando o servidor a cada passo e o poll do TCP a cada 500 ms
+static void run_ms(uint32_t ms) {
+    for (uint32_t t = 0; t < ms; t += STEP_MS) {
+        host_time_us += STEP_MS * 1000;
+        if (host_time_us % (TCP_TICK_MS * 1000) == 0) {
+            altcp_fake_tick();
+        }
+        server_step();
+    }
+}
+
+// Roda até a requisição (e as encadeadas) terminar
+static void run_until_idle(uint32_t limit_ms) {
+    for (uint32_t t = 0; t < limit_ms && http_request_busy(); t += STEP_MS) {
+        run_ms(STEP_MS);
+    }
+}
+
+// ----- Aplicação: mesmo papel dos ganchos de WeatherAssistant.c -----
+
+#define MAX_FINISHED 16
+
+static http_body_t body;
+static bool compression_enabled;
+static bool chain_forecast;             // Observação concluída -> previsão em seguida
+static uint32_t finished_count;
+static uint32_t results[REQUEST_TIMEOUT_TOTAL + 1];
+static struct {
+    request_kind_t kind;
+    request_result_t result;
+    uint32_t body_bytes;
+    uint64_t time_us;
+} finished[MAX_FINISHED];
+
+static void discard(void *ctx, const uint8_t *data, size_t len) {
+}
+
+static struct altcp_pcb *app_open(request_kind_t kind) {
+    opened_kind = kind;
+    http_body_init(&body, discard, NULL);
+    return altcp_fake_new();
+}
+
+static void app_connected(struct altcp_pcb *pcb, request_kind_t kind) {
+    static const char request[] = "GET /data/2.5/weather HTTP/1.1\r\n\r\n";
+    altcp_write(pcb, request, sizeof(request) - 1, TCP_WRITE_FLAG_COPY);
+    altcp_output(pcb);
+}
+
+static bool app_received(struct altcp_pcb *pcb, request_kind_t kind, struct pbuf *p) {
+    http_body_status_t status = HTTP_BODY_OK;
+    for (struct pbuf *q = p; q != NULL && status != HTTP_BODY_ERROR; q = q->next) {
+        status = http_body_feed(&body, q->payload, q->len);
+    }
+    return status != HTTP_BODY_ERROR;
+}
+
+static void app_finished(request_kind_t kind, request_result_t result) {
+    if (finished_count < MAX_FINISHED) {
+        finished[finished_count].kind = kind;
+        finished[finished_count].result = result;
+        finished[finished_count].body_bytes = body.body_bytes;
+        finished[finished_count].time_us = host_time_us;
+    }
+    finished_count++;
+    results[result]++;
+    if (result == REQUEST_DONE && kind == REQUEST_WEATHER && chain_forecast) {
+        http_request_start(REQUEST_FORECAST);
+    } else if (result == REQUEST_ABORTED && compression_enabled) {
+        compression_enabled = false;
+        http_request_start(kind);
+    }
+}
+
+static const http_request_hooks_t hooks = {
+    .open = app_open,
+    .connected = app_connected,
+    .received = app_received,
+    .finished = app_finished,
+};
+
+static void reset(behavior_t (*plan)(uint32_t)) {
+    static const ip_addr_t server_ip = {0};
+    altcp_fake_reset();
+    http_request_init(&hooks, &server_ip, 443);
+    server = (server_t){0};
+    server_config.connect_ms = 800;     // Handshake TLS completo no RP2040
+    server_config.ttfb_ms = 1500;
+    server_config.segment_ms = 300;
+    server_config.segment = 536;
+    server_config.plan = plan;
+    compression_enabled = true;
+    chain_forecast = false;
+    finished_count = 0;
+    memset(results, 0, sizeof(results));
+}
+
+// ----- Testes -----
+
+// 50 apertos em 1 s contra o servidor lento: uma conexão, o resto se junta a ela
+static void test_burst(void) {
+    reset(plan_normal);
+    for (int i = 0; i < 50; i++) {
+        http_request_start(REQUEST_WEATHER);
+        run_ms(20);
+    }
+    run_until_idle(60000);
+    const http_request_stats_t *stats = http_request_stats();
+    CHECK_EQ(stats->made, 1);
+    CHECK_EQ(stats->coalesced, 49);
+    CHECK_EQ(altcp_fake.max_live, 1);
+    CHECK_EQ(altcp_fake.closed, 1);
+    CHECK_EQ(altcp_fake.live, 0);
+    CHECK_EQ(altcp_fake.pbufs_live, 0);
+    CHECK_EQ(finished_count, 1);
+    CHECK_EQ(finished[0].result, REQUEST_DONE);
+    CHECK_EQ(finished[0].body_bytes, weather_wire.plain_len);
+}
+
+// Disparos da observação durante a previsão: uma única observação logo depois dela
+static void test_pending_after_forecast(void) {
+    reset(plan_normal);
+    http_request_start(REQUEST_FORECAST);
+    for (int i = 0; i < 20; i++) {
+        run_ms(100);
+        http_request_start(REQUEST_WEATHER);
+    }
+    run_until_idle(60000);
+    CHECK_EQ(http_request_stats()->made, 2);
+    CHECK_EQ(http_request_stats()->coalesced, 20);
+    CHECK_EQ(altcp_fake.max_live, 1);
+    CHECK_EQ(finished_count, 2);
+    CHECK_EQ(finished[0].kind, REQUEST_FORECAST);
+    CHECK_EQ(finished[0].body_bytes, forecast_wire.plain_len);
+    CHECK_EQ(finished[1].kind, REQUEST_WEATHER);
+    CHECK_EQ(finished[1].result, REQUEST_DONE);
+    CHECK_EQ(finished[1].body_bytes, weather_wire.plain_len);
+}
+
+// Cada prazo aborta a conexão no máximo um intervalo de poll depois de vencer
+static void test_timeouts(void) {
+    static const struct {
+        behavior_t behavior;
+        request_result_t result;
+        uint32_t timeout_ms;
+        bool from_connect;      // Prazo contado a partir da conexão pronta
+    } cases[] = {
+        {SERVER_NO_ACCEPT, REQUEST_TIMEOUT_CONNECT, HTTP_CONNECT_TIMEOUT_MS, false},
+        {SERVER_SILENT, REQUEST_TIMEOUT_FIRST_BYTE, HTTP_TTFB_TIMEOUT_MS, true},
+        {SERVER_STALL, REQUEST_TIMEOUT_TOTAL, HTTP_TOTAL_TIMEOUT_MS, false},
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        fixed_behavior = cases[i].behavior;
+        reset(plan_fixed);
+        run_ms(STEP_MS * (i + 1));      // Desalinha o início em relação ao ciclo do TCP
+        uint64_t started = host_time_us;
+        http_request_start(REQUEST_WEATHER);
+        run_until_idle(2 * HTTP_TOTAL_TIMEOUT_MS);
+
+        uint64_t deadline = (cases[i].from_connect ? server.connected_us : started) + cases[i].timeout_ms * 1000ull;
+        CHECK_EQ(finished_count, 1);
+        CHECK_EQ(finished[0].result, cases[i].result);
+        CHECK(finished[0].time_us >= deadline);
+        CHECK(finished[0].time_us <= deadline + POLL_MS * 1000ull);
+        CHECK_EQ(http_request_stats()->timed_out, 1);
+        CHECK_EQ(altcp_fake.aborted, 1);
+        CHECK_EQ(altcp_fake.live, 0);
+        CHECK_EQ(altcp_fake.pbufs_live, 0);
+        printf("prazo %-13s expirou %4llu ms depois do limite\n",
+               i == 0 ? "conexao" : i == 1 ? "primeiro byte" : "total",
+               (unsigned long long)(finished[0].time_us - deadline) / 1000);
+    }
+}
+
+// RST durante a previsão: falha, e a observação pendente roda em seguida
+static behavior_t plan_reset_first(uint32_t connection) {
+    return connection == 1 ? SERVER_RESET : SERVER_NORMAL;
+}
+
+static void test_error(void) {
+    reset(plan_reset_first);
+    http_request_start(REQUEST_FORECAST);
+    run_ms(100);
+    http_request_start(REQUEST_WEATHER);
+    run_until_idle(60000);
+    CHECK_EQ(http_request_stats()->failed, 1);
+    CHECK_EQ(http_request_stats()->last_error, ERR_RST);
+    CHECK_EQ(finished_count, 2);
+    CHECK_EQ(finished[0].result, REQUEST_FAILED);
+    CHECK_EQ(finished[1].kind, REQUEST_WEATHER);
+    CHECK_EQ(finished[1].result, REQUEST_DONE);
+    CHECK_EQ(altcp_fake.live, 0);
+
+    // altcp_connect recusado: a falha é avisada e nada fica aberto
+    reset(plan_normal);
+    altcp_fake.fail_connect = true;
+    CHECK(!http_request_start(REQUEST_WEATHER));
+    CHECK(!http_request_busy());
+    CHECK_EQ(finished_count, 1);
+    CHECK_EQ(finished[0].result, REQUEST_FAILED);
+    CHECK_EQ(altcp_fake.aborted, 1);
+    CHECK_EQ(altcp_fake.live, 0);
+}
+
+// Resposta recusada pelo decodificador: a aplicação repete sem compressão e a observação
+// pedida durante a previsão continua pendente até a repetição terminar
+static behavior_t plan_garbage_first(uint32_t connection) {
+    return connection == 1 ? SERVER_GARBAGE : SERVER_NORMAL;
+}
+
+static void test_abort_retry(void) {
+    reset(plan_garbage_first);
+    http_request_start(REQUEST_FORECAST);
+    run_ms(100);
+    http_request_start(REQUEST_WEATHER);
+    run_until_idle(60000);
+    CHECK_EQ(finished_count, 3);
+    CHECK_EQ(finished[0].result, REQUEST_ABORTED);
+    CHECK_EQ(finished[1].kind, REQUEST_FORECAST);
+    CHECK_EQ(finished[1].result, REQUEST_DONE);
+    CHECK_EQ(finished[2].kind, REQUEST_WEATHER);
+    CHECK_EQ(finished[2].result, REQUEST_DONE);
+    CHECK_EQ(altcp_fake.max_live, 1);
+    CHECK_EQ(altcp_fake.pbufs_live, 0);
+}
+
+// 10 minutos de disparos a cada 100 ms (um terço deles da previsão) contra um servidor que
+// às vezes não aceita, não responde, trava no meio, derruba a conexão ou manda lixo
+static unsigned soak_seed = 1;
+
+static behavior_t plan_mixed(uint32_t connection) {
+    soak_seed = soak_seed * 1103515245u + 12345u;
+    unsigned r = (soak_seed >> 16) % 20;
+    return r == 0 ? SERVER_NO_ACCEPT : r == 1 ? SERVER_SILENT : r == 2 ? SERVER_STALL :
+           r == 3 ? SERVER_RESET : r == 4 ? SERVER_GARBAGE : SERVER_NORMAL;
+}
+
+static void test_soak(void) {
+    const uint32_t duration_ms = 10 * 60 * 1000, trigger_ms = 100;
+    reset(plan_mixed);
+    chain_forecast = true;
+    server_config.connect_ms = 300;
+    server_config.ttfb_ms = 400;
+    server_config.segment_ms = 100;
+    printf("Estresse: %u s de disparos a cada %u ms\n", duration_ms / 1000, trigger_ms);    // Buffer do stdout antes da medição
+    struct mallinfo2 before = mallinfo2();
+
+    uint32_t triggers = 0;
+    unsigned seed = 7;
+    for (uint32_t t = 0; t < duration_ms; t += trigger_ms) {
+        seed = seed * 1103515245u + 12345u;
+        http_request_start((seed >> 16) % 3 == 0 ? REQUEST_FORECAST : REQUEST_WEATHER);
+        triggers++;
+        run_ms(trigger_ms);
+        CHECK(altcp_fake.live <= 1);
+    }
+    run_until_idle(2 * HTTP_TOTAL_TIMEOUT_MS);
+
+    const http_request_stats_t *stats = http_request_stats();
+    uint32_t timeouts = results[REQUEST_TIMEOUT_CONNECT] + results[REQUEST_TIMEOUT_FIRST_BYTE] + results[REQUEST_TIMEOUT_TOTAL];
+    printf("%u disparos: %u conexoes, %u agrupados, %u concluidas, %u expiradas, %u falhas, %u abortadas\n",
+           triggers, stats->made, stats->coalesced, results[REQUEST_DONE], timeouts, stats->failed,
+           results[REQUEST_ABORTED]);
+    printf("pico: %u conexao(oes), %u pbuf(s) de %d\n", altcp_fake.max_live, altcp_fake.pbufs_max, PBUF_POOL_SIZE);
+
+    CHECK_EQ(altcp_fake.max_live, 1);
+    CHECK_EQ(altcp_fake.live, 0);
+    CHECK_EQ(altcp_fake.pool_errors, 0);
+    CHECK_EQ(altcp_fake.pbufs_max, 1);  // Cada segmento volta ao pool dentro do callback
+    CHECK_EQ(altcp_fake.pbufs_live, 0);
+    CHECK_EQ(altcp_fake.opened, stats->made);
+    CHECK_EQ(finished_count, stats->made);  // Toda conexão aberta terminou uma única vez
+    CHECK_EQ(timeouts, stats->timed_out);
+    CHECK(stats->made + stats->coalesced >= triggers);
+    CHECK(timeouts > 0 && stats->failed > 0 && results[REQUEST_ABORTED] > 0);
+    CHECK_EQ(mallinfo2().uordblks, before.uordblks);
+}
+
+static void load_wire(wire_t *wire, const char *file, const char *encoding, const char *plain) {
+    size_t body_len, plain_len;
+    uint8_t *body_data = test_load(fixtures, file, &body_len);
+    free(test_load(fixtures, plain, &plain_len));
+    wire->len = mock_response(wire->data, sizeof(wire->data), 200, encoding, 0, body_data, body_len);
+    wire->plain_len = plain_len;
+    free(body_data);
+}
+
+int main(int argc, char **argv) {
+    fixtures = argc > 1 ? argv[1] : "fixtures";
+    load_wire(&weather_wire, "weather.json", NULL, "weather.json");
+    load_wire(&forecast_wire, "forecast.json.gz", "gzip", "forecast.json");
+    load_wire(&garbage_wire, "far_reference.txt.gz", "gzip", "far_reference.txt");
+
+    test_burst();
+    test_pending_after_forecast();
+    test_timeouts();
+    test_error();
+    test_abort_retry();
+    test_soak();
+    return test_report("http_request");
+}
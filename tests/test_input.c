@@ -0,0 +1,165 @@
+// Testes da máquina de estados de debounce (inc/debounce.c) com traços de bordas em
+// tests/fixtures/*.trace (gerados por make_fixtures.py). O teste faz o papel de inc/input.c:
+// as bordas entram como se viessem da IRQ e, a cada INPUT_TICK_MS, o nível atual de cada pino
+// é passado ao tick, como o gpio_get no timer de debounce.
+#include <string.h>
+#include "test.h"
+#include "inc/debounce.h"
+
+#define MAX_EDGES 256
+#define MAX_EVENTS 64
+#define TOLERANCE_MS 5
+
+typedef struct {
+    uint64_t time_us;
+    uint8_t gpio;
+    bool level;
+} edge_t;
+
+typedef struct {
+    uint8_t gpio;
+    input_event_type_t type;
+    uint32_t time_ms;
+} expected_t;
+
+static const char *fixtures;
+static input_event_t events[MAX_EVENTS];
+static uint64_t emitted_us[MAX_EVENTS];     // Tick em que cada evento saiu
+static int event_count;
+static uint64_t tick_us;
+
+static void collect(uint8_t gpio, input_event_type_t type, uint32_t time_ms) {
+    if (event_count < MAX_EVENTS) {
+        emitted_us[event_count] = tick_us;
+        events[event_count++] = (input_event_t){gpio, type, time_ms};
+    }
+}
+
+static int load_trace(const char *name, edge_t *edges) {
+    size_t len;
+    char *text = (char *)test_load(fixtures, name, &len);
+    int count = 0;
+    for (char *line = strtok(text, "\n"); line != NULL; line = strtok(NULL, "\n")) {
+        unsigned long long time_us;
+        unsigned gpio, level;
+        if (line[0] != '#' && sscanf(line, "%llu %u %u", &time_us, &gpio, &level) == 3 && count < MAX_EDGES) {
+            edges[count++] = (edge_t){time_us, (uint8_t)gpio, level != 0};
+        }
+    }
+    free(text);
+    return count;
+}
+
+// Reproduz o traço com três pinos (A, B e joystick) soltos no início
+static void replay(const edge_t *edges, int count) {
+    static const uint8_t gpios[] = {5, 6, 22};
+    debounce_t pins[3];
+    bool level[3];
+    for (int i = 0; i < 3; i++) {
+        debounce_init(&pins[i], gpios[i], false);
+        level[i] = true;
+    }
+    event_count = 0;
+
+    int next = 0;
+    uint64_t end_us = edges[count - 1].time_us + 1500 * 1000;
+    for (tick_us = edges[0].time_us - 10 * 1000; tick_us < end_us; tick_us += INPUT_TICK_MS * 1000) {
+        for (; next < count && edges[next].time_us <= tick_us; next++) {
+            for (int i = 0; i < 3; i++) {
+                if (gpios[i] == edges[next].gpio) {
+                    debounce_edge(&pins[i], edges[next].time_us);
+                    level[i] = edges[next].level;
+                }
+            }
+        }
+        for (int i = 0; i < 3; i++) {
+            debounce_tick(&pins[i], !level[i], tick_us, collect);
+        }
+    }
+}
+
+static void check_events(const char *name, const expected_t *expected, int count) {
+    static const char *types[] = {"PRESS", "RELEASE", "LONG", "REPEAT"};
+    bool ok = event_count == count;
+    for (int i = 0; ok && i < count; i++) {
+        long diff = (long)events[i].time_ms - (long)expected[i].time_ms;
+        ok = events[i].gpio == expected[i].gpio && events[i].type == expected[i].type &&
+             diff >= -TOLERANCE_MS && diff <= TOLERANCE_MS;
+    }
+    if (!ok) {
+        fprintf(stderr, "%s: eventos diferentes do esperado:\n", name);
+        for (int i = 0; i < event_count; i++) {
+            fprintf(stderr, "  %2u %-7s %lu ms\n", events[i].gpio, types[events[i].type], (unsigned long)events[i].time_ms);
+        }
+        test_failures++;
+    }
+}
+
+// Latência de press/release: da última borda da trepidação até o tick que gera o evento fica
+// abaixo de INPUT_DEBOUNCE_US + INPUT_TICK_MS; do início da rajada depende da chave e só é impressa
+static void check_latency(const edge_t *edges, int count) {
+    uint64_t worst_settle = 0, worst_start = 0;
+    for (int e = 0; e < event_count; e++) {
+        if (events[e].type != INPUT_PRESS && events[e].type != INPUT_RELEASE) {
+            continue;
+        }
+        uint64_t start = 0, settle = 0;
+        for (int i = 0; i < count; i++) {
+            if (edges[i].gpio != events[e].gpio || edges[i].time_us > emitted_us[e]) {
+                continue;
+            }
+            if (start == 0 || edges[i].time_us - settle > INPUT_DEBOUNCE_US) {
+                start = edges[i].time_us;   // Borda depois de um intervalo estável: nova rajada
+            }
+            settle = edges[i].time_us;
+        }
+        uint64_t latency = emitted_us[e] - settle;
+        worst_settle = latency > worst_settle ? latency : worst_settle;
+        latency = emitted_us[e] - start;
+        worst_start = latency > worst_start ? latency : worst_start;
+    }
+    CHECK(worst_settle <= INPUT_DEBOUNCE_US + INPUT_TICK_MS * 1000);
+    printf("pior latência press/release: %.2f ms após a última borda, %.2f ms após a primeira\n",
+           worst_settle / 1000.0, worst_start / 1000.0);
+}
+
+static void test_presses(void) {
+    static const expected_t expected[] = {
+        {5, INPUT_PRESS, 1000}, {5, INPUT_RELEASE, 1151},
+        // O espúrio de 300 µs em 1500 ms não gera nada
+        {5, INPUT_PRESS, 2002}, {5, INPUT_RELEASE, 2063},
+        {5, INPUT_PRESS, 2121}, {5, INPUT_RELEASE, 2182},
+        {6, INPUT_PRESS, 3001}, {5, INPUT_PRESS, 3101}, {5, INPUT_RELEASE, 3202}, {6, INPUT_RELEASE, 3402},
+        {22, INPUT_PRESS, 4001}, {22, INPUT_LONG_PRESS, 4803},
+        {22, INPUT_REPEAT, 5003}, {22, INPUT_REPEAT, 5203}, {22, INPUT_REPEAT, 5403},
+        {22, INPUT_RELEASE, 5503},
+    };
+    static edge_t edges[MAX_EDGES];
+    int count = load_trace("bounce_presses.trace", edges);
+    replay(edges, count);
+    check_events("bounce_presses.trace", expected, sizeof(expected) / sizeof(expected[0]));
+    check_latency(edges, count);
+}
+
+// Segurado atravessando 2^32 µs: long-press uma vez e repetições a cada 200 ms, sem salto
+static void test_wrap(void) {
+    static const expected_t expected[] = {
+        {6, INPUT_PRESS, 4294468}, {6, INPUT_LONG_PRESS, 4295269},
+        {6, INPUT_REPEAT, 4295469}, {6, INPUT_REPEAT, 4295669}, {6, INPUT_REPEAT, 4295869},
+        {6, INPUT_REPEAT, 4296069}, {6, INPUT_REPEAT, 4296269}, {6, INPUT_REPEAT, 4296469},
+        {6, INPUT_RELEASE, 4296570},
+        {5, INPUT_PRESS, 4297469}, {5, INPUT_RELEASE, 4297520},
+    };
+    static edge_t edges[MAX_EDGES];
+    int count = load_trace("bounce_wrap.trace", edges);
+    replay(edges, count);
+    check_events("bounce_wrap.trace", expected, sizeof(expected) / sizeof(expected[0]));
+    check_latency(edges, count);
+}
+
+int main(int argc, char **argv) {
+    fixtures = argc > 1 ? argv[1] : "fixtures";
+    test_presses();
+    test_wrap();
+    return test_report("input");
+}
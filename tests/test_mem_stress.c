@@ -0,0 +1,203 @@
+// Estresse de memória no host: milhares de respostas (observação e previsão, com e sem
+// compressão/chunked) passam pelo mesmo caminho do firmware - gerenciador de requisições
+// (inc/http_request.c) sobre o altcp simulado, com pbufs de um pool do tamanho de PBUF_POOL_SIZE,
+// http_body, buffer de resposta (inc/response_buffer.c) e extrator da previsão - numa thread cuja
+// pilha é pintada por inc/mem_report.c. No fim imprime o relatório de memória do firmware e
+// confere que o heap não cresceu depois da inicialização e que nenhum pool estourou.
+//
+// Os pools de pbufs e de PCBs do relatório vêm dos contadores do altcp simulado. O heap do lwIP
+// (MEM_SIZE) não é simulado: no relatório só o total é real, e o uso só é medido na placa.
+#include <pthread.h>
+#include <string.h>
+#include <malloc.h>
+#include "test.h"
+#include "mock_server.h"
+#include "lwipopts.h"
+#include "lwip/stats.h"
+#include "inc/http_request.h"
+#include "inc/http_body.h"
+#include "inc/response_buffer.h"
+#include "inc/forecast.h"
+#include "inc/mem_report.h"
+
+#define RESPONSES 5000
+#define HOST_STACK_SIZE (64 * 1024)     // Mesmo valor do --defsym em tests/CMakeLists.txt
+#define MIN_SEGMENT 536                 // MSS mínimo do TCP; com TCP_WND cabe no pool de pbufs
+
+uint64_t host_time_us;
+struct stats_ lwip_stats;
+static struct stats_mem pbuf_pool = {.name = "PBUF_POOL", .avail = PBUF_POOL_SIZE};
+static struct stats_mem tcp_pcb_pool = {.name = "TCP_PCB", .avail = ALTCP_FAKE_PCBS};
+
+// Pilha da thread de estresse; o linker define __StackBottom/__StackTop nas pontas dela
+uint32_t host_stack[HOST_STACK_SIZE / sizeof(uint32_t)] __attribute__((aligned(16)));
+
+static const char *fixtures;
+static http_body_t response_body;
+
+static size_t decoder_size(void) {
+    return sizeof(response_body);
+}
+
+// Ganchos no papel dos de WeatherAssistant.c, com o mesmo sink e o mesmo extrator
+static struct altcp_pcb *stress_open(request_kind_t kind) {
+    if (kind == REQUEST_FORECAST) {
+        forecast_begin();
+        http_body_init(&response_body, forecast_sink, NULL);
+    } else {
+        http_body_init(&response_body, response_sink, NULL);
+    }
+    response_buffer_reset();
+    return altcp_fake_new();
+}
+
+static void stress_connected(struct altcp_pcb *pcb, request_kind_t kind) {
+}
+
+static bool stress_received(struct altcp_pcb *pcb, request_kind_t kind, struct pbuf *p) {
+    http_body_status_t status = HTTP_BODY_OK;
+    for (struct pbuf *q = p; q != NULL && status != HTTP_BODY_ERROR; q = q->next) {
+        status = http_body_feed(&response_body, q->payload, q->len);
+    }
+    return status != HTTP_BODY_ERROR;
+}
+
+static request_result_t last_result;
+
+static void stress_finished(request_kind_t kind, request_result_t result) {
+    last_result = result;
+}
+
+static const http_request_hooks_t hooks = {
+    .open = stress_open,
+    .connected = stress_connected,
+    .received = stress_received,
+    .finished = stress_finished,
+};
+
+// Contadores do altcp simulado -> estatísticas que o relatório do firmware imprime
+static void update_stats(void) {
+    pbuf_pool.used = altcp_fake.pbufs_live;
+    pbuf_pool.max = altcp_fake.pbufs_max;
+    pbuf_pool.err = altcp_fake.pool_errors;
+    tcp_pcb_pool.used = altcp_fake.live;
+    tcp_pcb_pool.max = altcp_fake.max_live;
+}
+
+typedef struct {
+    const char *file;
+    const char *encoding;
+    size_t chunk;
+    bool forecast;
+    uint8_t *wire;
+    size_t wire_len;
+    size_t plain_len;
+} case_t;
+
+static case_t cases[] = {
+    {.file = "weather.json", .encoding = NULL, .chunk = 0, .forecast = false},
+    {.file = "weather.json.gz", .encoding = "gzip", .chunk = 0, .forecast = false},
+    {.file = "weather.json.zz", .encoding = "deflate", .chunk = 128, .forecast = false},
+    {.file = "forecast.json", .encoding = NULL, .chunk = 700, .forecast = true},
+    {.file = "forecast.json.gz", .encoding = "gzip", .chunk = 0, .forecast = true},
+    {.file = "forecast.json.deflate", .encoding = "deflate", .chunk = 1000, .forecast = true},
+};
+#define CASES (sizeof(cases) / sizeof(cases[0]))
+
+// O servidor completa a conexão e manda a resposta em janelas TCP inteiras (segmentos de
+// MIN_SEGMENT a TCP_MSS bytes, um pbuf do pool cada) antes de o callback de recepção rodar;
+// o gerenciador de requisições passa a cadeia ao http_body e devolve os pbufs
+static void serve(case_t *c, unsigned *seed) {
+    http_request_start(c->forecast ? REQUEST_FORECAST : REQUEST_WEATHER);
+    struct altcp_pcb *conn = altcp_fake_active();
+    CHECK(conn != NULL);
+    if (conn == NULL) {
+        return;
+    }
+    altcp_fake_connect_done(conn);
+    size_t pos = 0;
+    while (pos < c->wire_len && http_request_busy()) {
+        *seed = *seed * 1103515245u + 12345u;
+        size_t segment = MIN_SEGMENT + (*seed >> 16) % (TCP_MSS - MIN_SEGMENT + 1);
+        size_t window = c->wire_len - pos < TCP_WND ? c->wire_len - pos : TCP_WND;
+        altcp_fake_deliver(conn, c->wire + pos, window, segment);
+        update_stats();
+        pos += window;
+    }
+    if (http_request_busy()) {
+        altcp_fake_remote_close(conn);
+    }
+    update_stats();
+}
+
+static void *stress(void *arg) {
+    mem_report_init();  // Pinta a pilha desta thread
+    mem_report_add_arena("resposta", RESPONSE_BUFFER_SIZE, response_buffer_high_water);
+    mem_report_add_arena("decodificador", sizeof(response_body), decoder_size);
+    printf("Estresse: %d respostas\n", RESPONSES);  // Buffer do stdout alocado antes do fim do init
+    struct mallinfo2 before = mallinfo2();
+    mem_report_end_init();
+
+    unsigned seed = 1;
+    for (int r = 0; r < RESPONSES; r++) {
+        case_t *c = &cases[r % CASES];
+        serve(c, &seed);
+
+        CHECK_EQ(last_result, REQUEST_DONE);
+        CHECK_EQ(response_body.body_bytes, c->plain_len);
+        if (c->forecast) {
+            CHECK(forecast_commit());
+            CHECK_EQ(forecast_count(), FORECAST_MAX_POINTS);
+        } else {
+            CHECK_EQ(response_buffer_length(), c->plain_len);
+        }
+    }
+
+    mem_report_print();
+    printf("Obs.: o heap do lwIP não é simulado no host; o uso de MEM_SIZE só é medido na placa\n");
+    CHECK_EQ(mallinfo2().uordblks, before.uordblks);
+    CHECK_EQ(http_request_stats()->made, RESPONSES);
+    CHECK_EQ(altcp_fake.pool_errors, 0);
+    CHECK_EQ(altcp_fake.max_live, 1);
+    CHECK_EQ(altcp_fake.live, 0);
+    CHECK_EQ(altcp_fake.pbufs_live, 0);
+    CHECK(response_buffer_high_water() < RESPONSE_BUFFER_SIZE - 1);   // Nenhuma observação foi truncada
+    return NULL;
+}
+
+int main(int argc, char **argv) {
+    fixtures = argc > 1 ? argv[1] : "fixtures";
+    // Heap do lwIP: só o total (MEM_SIZE); o uso fica em zero até ser medido na placa
+    lwip_stats.mem = (struct stats_mem){.name = "HEAP", .avail = MEM_SIZE};
+    lwip_stats.memp[MEMP_TCP_PCB] = &tcp_pcb_pool;
+    lwip_stats.memp[MEMP_PBUF_POOL] = &pbuf_pool;
+    static const ip_addr_t server_ip = {0};
+    altcp_fake_reset();
+    http_request_init(&hooks, &server_ip, 443);
+
+    static uint8_t wires[CASES][8192];
+    for (size_t i = 0; i < CASES; i++) {
+        size_t body_len, plain_len;
+        char plain_name[64];
+        uint8_t *body = test_load(fixtures, cases[i].file, &body_len);
+        snprintf(plain_name, sizeof(plain_name), "%s", cases[i].file);
+        *strstr(plain_name, ".json") = '\0';
+        strcat(plain_name, ".json");
+        free(test_load(fixtures, plain_name, &plain_len));
+        cases[i].wire = wires[i];
+        cases[i].wire_len = mock_response(wires[i], sizeof(wires[i]), 200, cases[i].encoding, cases[i].chunk, body, body_len);
+        cases[i].plain_len = plain_len;
+        free(body);
+    }
+
+    pthread_attr_t attr;
+    pthread_t thread;
+    pthread_attr_init(&attr);
+    pthread_attr_setstack(&attr, host_stack, sizeof(host_stack));
+    if (pthread_create(&thread, &attr, stress, NULL) != 0) {
+        perror("pthread_create");
+        return 1;
+    }
+    pthread_join(thread, NULL);
+    return test_report("mem_stress");
+}
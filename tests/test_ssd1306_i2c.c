@@ -0,0 +1,190 @@
+// Testes do transporte I2C do display (inc/ssd1306.c) sobre o barramento simulado de
+// tools/host/hardware/i2c.c, que injeta NAKs e timeouts conforme a velocidade: calibração,
+// descida de velocidade a cada erro em ssd1306_write, volta depois de escritas sem erro e
+// contagem de repetições.
+#include <string.h>
+#include "test.h"
+#include "inc/ssd1306.h"
+
+static const uint32_t speeds[] = SSD1306_I2C_SPEEDS;
+#define SPEED_COUNT (sizeof(speeds) / sizeof(speeds[0]))
+#define TOP_SPEED speeds[SPEED_COUNT - 1]
+
+static ssd1306_t ssd;
+
+static void setup_bus(const i2c_mock_band_t *bands, size_t count) {
+    i2c_mock_reset();
+    for (size_t i = 0; i < count; i++) {
+        i2c_mock.bands[i] = bands[i];
+    }
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, NULL);
+}
+
+// Barramento limpo: sobe até a maior velocidade da lista, que sem SSD1306_I2C_ABOVE_SPEC é o
+// limite de 400 kHz do SSD1306
+static void test_calibrate_clean(void) {
+    setup_bus(NULL, 0);
+    CHECK_EQ(TOP_SPEED, 400000);
+    CHECK_EQ(ssd1306_calibrate(&ssd), TOP_SPEED);
+    CHECK_EQ(ssd.speed_index, SPEED_COUNT - 1);
+    CHECK_EQ(i2c_mock.baudrate, TOP_SPEED);
+    // Cada velocidade: SSD1306_CALIBRATION_TRIALS x (comando + leitura do status)
+    CHECK_EQ(i2c_mock.transactions, SPEED_COUNT * SSD1306_CALIBRATION_TRIALS * 2);
+}
+
+// Acima de 200 kHz toda transação falha (fiação longa): fica em 200 kHz
+static void test_calibrate_limit(void) {
+    static const i2c_mock_band_t bands[] = {{200000, 0}};
+    setup_bus(bands, 1);
+    CHECK_EQ(ssd1306_calibrate(&ssd), 200000);
+    CHECK_EQ(i2c_mock.baudrate, 200000);
+}
+
+// Em 400 kHz falha 1 a cada 20 transações: uma falha nas tentativas já descarta a velocidade
+static void test_calibrate_marginal(void) {
+    static const i2c_mock_band_t bands[] = {{200000, 0}, {400000, 20}};
+    setup_bus(bands, 2);
+    CHECK_EQ(ssd1306_calibrate(&ssd), 200000);
+
+    // Timeout em vez de NAK tem o mesmo efeito
+    setup_bus(bands, 2);
+    i2c_mock.error = PICO_ERROR_TIMEOUT;
+    CHECK_EQ(ssd1306_calibrate(&ssd), 200000);
+}
+
+// Display desligado (bit 6 do status): nenhuma velocidade é confirmada, fica na mais lenta
+static void test_calibrate_display_off(void) {
+    setup_bus(NULL, 0);
+    i2c_mock.status = 0x40;
+    CHECK_EQ(ssd1306_calibrate(&ssd), speeds[0]);
+}
+
+// Um erro num comando: conta o erro, desce uma velocidade e repete
+static void test_step_down(void) {
+    setup_bus(NULL, 0);
+    ssd1306_calibrate(&ssd);
+    i2c_mock.error = PICO_ERROR_TIMEOUT;
+    i2c_mock.fail_next = 1;
+    ssd1306_command(&ssd, SET_DISP | 0x01);
+    CHECK_EQ(ssd.i2c_errors, 1);
+    CHECK_EQ(ssd.i2c_retries, 1);
+    CHECK_EQ(ssd.baudrate, speeds[SPEED_COUNT - 2]);
+    CHECK_EQ(i2c_mock.baudrate, speeds[SPEED_COUNT - 2]);
+    CHECK_EQ(i2c_mock.last_write_len, 2);
+    CHECK_EQ(i2c_mock.last_write[1], SET_DISP | 0x01);
+}
+
+// Erros seguidos: SSD1306_I2C_RETRIES repetições, a velocidade desce até a mínima e o comando
+// é abandonado; o próximo passa normalmente
+static void test_retries_exhausted(void) {
+    setup_bus(NULL, 0);
+    ssd1306_calibrate(&ssd);
+    i2c_mock.fail_next = SSD1306_I2C_RETRIES + 1;
+    i2c_mock.last_write_len = 0;
+    ssd1306_command(&ssd, SET_CONTRAST);
+    CHECK_EQ(ssd.i2c_errors, SSD1306_I2C_RETRIES + 1);
+    CHECK_EQ(ssd.i2c_retries, SSD1306_I2C_RETRIES + 1);
+    int lowest = (int)SPEED_COUNT - 1 - (SSD1306_I2C_RETRIES + 1);    // Uma velocidade a menos por erro
+    CHECK_EQ(ssd.speed_index, lowest < 0 ? 0 : lowest);
+    CHECK_EQ(i2c_mock.last_write_len, 0);
+
+    ssd1306_command(&ssd, SET_CONTRAST);
+    CHECK_EQ(ssd.i2c_errors, SSD1306_I2C_RETRIES + 1);
+    CHECK_EQ(i2c_mock.last_write[1], SET_CONTRAST);
+}
+
+// Falha na escrita dos dados do quadro: endereçamento + dados são repetidos inteiros
+static void test_frame_retry(void) {
+    static uint8_t frame[WIDTH * HEIGHT / 8 + 1];
+    for (size_t i = 0; i < sizeof(frame); i++) {
+        frame[i] = (uint8_t)(i * 37);
+    }
+    frame[0] = 0x40;
+    setup_bus(NULL, 0);
+    ssd1306_calibrate(&ssd);
+    uint32_t before = i2c_mock.transactions;
+    i2c_mock.fail_at = before + 7;   // 6 comandos de endereçamento + dados
+    ssd1306_send_frame(&ssd, frame);
+    CHECK_EQ(i2c_mock.transactions - before, 14);
+    CHECK_EQ(ssd.i2c_errors, 1);
+    CHECK_EQ(ssd.i2c_retries, 1);
+    CHECK_EQ(ssd.baudrate, speeds[SPEED_COUNT - 2]);
+    CHECK_EQ(i2c_mock.last_write_len, sizeof(frame));
+    CHECK(memcmp(i2c_mock.last_write, frame, sizeof(frame)) == 0);
+}
+
+// Erros passageiros derrubam a velocidade até 100 kHz; cada SSD1306_I2C_STEP_UP_AFTER escritas
+// sem erro sobem uma, até a velocidade da calibração e não além dela
+static void test_step_up(void) {
+    static const i2c_mock_band_t bands[] = {{200000, 0}};
+    setup_bus(bands, 1);
+    CHECK_EQ(ssd1306_calibrate(&ssd), 200000);
+    uint32_t faults = i2c_mock.faults;     // Inclui as falhas em 400 kHz da calibração
+    i2c_mock.fail_next = 2;
+    ssd1306_command(&ssd, SET_CONTRAST);
+    CHECK_EQ(ssd.baudrate, 100000);
+
+    for (int n = 1; n < SSD1306_I2C_STEP_UP_AFTER; n++) {
+        ssd1306_command(&ssd, SET_CONTRAST);    // A repetição que passou já conta uma
+    }
+    CHECK_EQ(ssd.baudrate, 200000);
+    CHECK_EQ(i2c_mock.baudrate, 200000);
+    for (int n = 0; n < 4 * SSD1306_I2C_STEP_UP_AFTER; n++) {
+        ssd1306_command(&ssd, SET_CONTRAST);
+    }
+    CHECK_EQ(ssd.baudrate, 200000);     // 400 kHz não passou na calibração
+    CHECK_EQ(i2c_mock.faults - faults, 2);
+
+    // Um erro no meio zera a contagem
+    setup_bus(NULL, 0);
+    ssd1306_calibrate(&ssd);
+    i2c_mock.fail_next = 1;
+    ssd1306_command(&ssd, SET_CONTRAST);
+    for (int n = 1; n < SSD1306_I2C_STEP_UP_AFTER - 1; n++) {
+        ssd1306_command(&ssd, SET_CONTRAST);
+    }
+    i2c_mock.fail_next = 1;
+    ssd1306_command(&ssd, SET_CONTRAST);
+    CHECK_EQ(ssd.baudrate, speeds[SPEED_COUNT - 3]);
+}
+
+// Barramento ruidoso (1 falha a cada 300 transações em qualquer velocidade): todos os quadros
+// chegam, cada falha vira um erro e uma repetição, os prazos acompanham a velocidade e o
+// barramento não fica preso na mais lenta
+static void test_noisy_bus(void) {
+    static const i2c_mock_band_t bands[] = {{TOP_SPEED, 300}};
+    static uint8_t frame[WIDTH * HEIGHT / 8 + 1];
+    setup_bus(bands, 1);
+    ssd1306_calibrate(&ssd);
+    uint32_t faults = i2c_mock.faults;
+    int delivered = 0;
+    for (int n = 0; n < 200; n++) {
+        frame[0] = 0x40;
+        memset(frame + 1, n, sizeof(frame) - 1);
+        i2c_mock.last_write_len = 0;
+        ssd1306_send_frame(&ssd, frame);
+        delivered += i2c_mock.last_write_len == sizeof(frame) && memcmp(i2c_mock.last_write, frame, sizeof(frame)) == 0;
+    }
+    CHECK_EQ(delivered, 200);
+    CHECK(i2c_mock.faults > faults);
+    CHECK_EQ(ssd.i2c_errors, i2c_mock.faults - faults);
+    CHECK_EQ(ssd.i2c_retries, ssd.i2c_errors);  // No máximo uma falha por tentativa de 7 transações
+    CHECK_EQ(i2c_mock.short_timeouts, 0);
+    CHECK(ssd.baudrate > speeds[0]);
+    printf("barramento ruidoso: %lu falhas em %lu transações, %lu repetições, terminou em %lu Hz\n",
+           (unsigned long)(i2c_mock.faults - faults), (unsigned long)i2c_mock.transactions,
+           (unsigned long)ssd.i2c_retries, (unsigned long)ssd.baudrate);
+}
+
+int main(void) {
+    test_calibrate_clean();
+    test_calibrate_limit();
+    test_calibrate_marginal();
+    test_calibrate_display_off();
+    test_step_down();
+    test_retries_exhausted();
+    test_frame_retry();
+    test_step_up();
+    test_noisy_bus();
+    return test_report("ssd1306_i2c");
+}
@@ -0,0 +1,41 @@
+// Testes das telas de status: o renderizador compartilhado (inc/status_screens.c), usado pelo
+// gerador de quadros e pelo firmware sem quadros pré-gerados, contra as referências versionadas
+// em tests/fixtures/status_frames. A mesma comparação roda no build do firmware sobre os
+// quadros que vão para a flash (tools/verify_status_frames.c).
+#include "test.h"
+#include "status_golden.h"
+
+static void flip_pixel(uint8_t *frame, int x, int y) {
+    frame[1 + x * 8 + y / 8] ^= 1 << (y & 7);
+}
+
+int main(int argc, char **argv) {
+    const char *dir = argc > 1 ? argv[1] : "fixtures/status_frames";
+    ssd1306_t ssd;
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, NULL);
+    for (int s = 0; s < STATUS_SCREEN_COUNT; s++) {
+        status_screen_render(&ssd, s);
+        CHECK_EQ(status_golden_compare(dir, s, ssd.ram_buffer, stderr), 0);
+    }
+
+    // Tela 0 ("CONECTANDO A" + SSID): um pixel trocado fora da linha do SSID tem que ser
+    // apontado, com a posição na mensagem; dentro dela é ignorado, porque o SSID muda com a
+    // configuração. As mensagens vão para um arquivo temporário em vez do stderr.
+    int index = 0 - STATUS_SCREEN_FIRST;
+    FILE *log = tmpfile();
+    CHECK(log != NULL);
+    status_screen_render(&ssd, index);
+    flip_pixel(ssd.ram_buffer, 64, 0);
+    CHECK_EQ(status_golden_compare(dir, index, ssd.ram_buffer, log), 1);
+    char message[512] = {0};
+    rewind(log);
+    CHECK(fgets(message, sizeof(message), log) != NULL);
+    CHECK(strstr(message, "tela 0: pixel x=64 y=0 difere") == message);
+    fclose(log);
+
+    status_screen_render(&ssd, index);
+    CHECK(status_golden_masked(index, 40, 36));
+    flip_pixel(ssd.ram_buffer, 40, 36);
+    CHECK_EQ(status_golden_compare(dir, index, ssd.ram_buffer, NULL), 0);
+    return test_report("status_screens");
+}
@@ -0,0 +1,180 @@
+// Testes dos kernels de decimação do sensor de temperatura (inc/temp_filter.c) com sinais
+// sintéticos: leitura constante do sensor com ruído do ADC, rampa de aquecimento e ruído
+// periódico. Confere as saídas contra um FIR direto (caixa convoluída 'ordem' vezes), mede a
+// redução de ruído e imprime os ciclos por saída de cada kernel no tamanho usado no firmware.
+#include <math.h>
+#include <string.h>
+#include "test.h"
+#include "inc/temp_filter.h"
+#include "inc/temp_sensor.h"
+
+#define RING_MASK (TEMP_RING_SAMPLES - 1)
+
+static uint16_t ring[TEMP_RING_SAMPLES];
+static unsigned seed = 1;
+
+static double uniform(void) {
+    seed = seed * 1103515245u + 12345u;
+    return ((seed >> 8) & 0xFFFF) / 65536.0;
+}
+
+// Ruído gaussiano (Box-Muller) com desvio 'sigma' LSB
+static double gaussian(double sigma) {
+    double u = uniform() + 1e-9, v = uniform();
+    return sigma * sqrt(-2 * log(u)) * cos(2 * M_PI * v);
+}
+
+static uint16_t adc(double value) {
+    long code = lround(value);
+    return (uint16_t)(code < 0 ? 0 : code > 4095 ? 4095 : code);
+}
+
+// Coeficientes do FIR equivalente ao CIC: caixa de R uns convoluída 'order' vezes
+static int fir_taps(uint8_t order, uint32_t r, uint64_t *taps) {
+    int len = 1;
+    taps[0] = 1;
+    for (uint8_t k = 0; k < order; k++) {
+        uint64_t next[TEMP_FILTER_MAX_ORDER * 256] = {0};
+        for (int i = 0; i < len; i++) {
+            for (uint32_t j = 0; j < r; j++) {
+                next[i + j] += taps[i];
+            }
+        }
+        len += r - 1;
+        memcpy(taps, next, len * sizeof(uint64_t));
+    }
+    return len;
+}
+
+static uint64_t fir(const uint64_t *taps, int len, uint32_t newest) {
+    uint64_t sum = 0;
+    for (int i = 0; i < len; i++) {
+        sum += taps[i] * ring[(newest - i) & RING_MASK];
+    }
+    return sum;
+}
+
+// Ruído branco em torno de uma leitura típica (~27 °C), com o índice dando voltas no buffer
+static void test_against_fir(void) {
+    static const uint32_t rates[] = {4, 16, 64};
+    static uint64_t taps[TEMP_FILTER_MAX_ORDER * 256];
+    for (uint32_t i = 0; i < TEMP_RING_SAMPLES; i++) {
+        ring[i] = adc(876 + gaussian(4));
+    }
+    for (size_t ri = 0; ri < sizeof(rates) / sizeof(rates[0]); ri++) {
+        uint32_t r = rates[ri];
+        CHECK_EQ(temp_filter_moving_average(ring, RING_MASK, 3, r), fir(taps, fir_taps(1, r, taps), 3));
+        for (uint8_t order = 1; order <= TEMP_FILTER_MAX_ORDER; order++) {
+            if (order * r > TEMP_RING_SAMPLES) {
+                continue;
+            }
+            int len = fir_taps(order, r, taps);
+            for (uint32_t newest = 0; newest < TEMP_RING_SAMPLES; newest += 37) {
+                uint64_t expected = fir(taps, len, newest);
+                if (12 + order * log2(r) <= 32) {   // Limite de bits do comentário em temp_filter.c
+                    CHECK_EQ(temp_filter_cic(ring, RING_MASK, newest, order, r), expected);
+                }
+            }
+        }
+    }
+}
+
+// Desvio padrão das saídas normalizadas (soma / R^ordem) sobre vários buffers de ruído puro
+static double output_sigma(uint8_t order, double sigma) {
+    const int outputs = 2000;
+    double sum = 0, sum2 = 0, gain = pow(TEMP_DECIMATION, order);
+    for (int n = 0; n < outputs; n++) {
+        for (uint32_t i = 0; i < TEMP_RING_SAMPLES; i++) {
+            ring[i] = adc(2048 + gaussian(sigma));
+        }
+        double y = (order == 1 ? temp_filter_moving_average(ring, RING_MASK, RING_MASK, TEMP_DECIMATION)
+                               : temp_filter_cic(ring, RING_MASK, RING_MASK, order, TEMP_DECIMATION)) / gain;
+        sum += y;
+        sum2 += y * y;
+    }
+    double mean = sum / outputs;
+    return sqrt(sum2 / outputs - mean * mean);
+}
+
+// Redução do ruído branco: teórica = sqrt(soma(h)^2 / soma(h^2)); medida com 2000 saídas
+static void test_noise_reduction(void) {
+    static uint64_t taps[TEMP_FILTER_MAX_ORDER * 256];
+    const double sigma = 8;
+    for (uint8_t order = 1; order <= 2; order++) {
+        int len = fir_taps(order, TEMP_DECIMATION, taps);
+        double sum = 0, sum2 = 0;
+        for (int i = 0; i < len; i++) {
+            sum += taps[i];
+            sum2 += (double)taps[i] * taps[i];
+        }
+        double expected = sqrt(sum * sum / sum2);
+        double measured = sigma / output_sigma(order, sigma);
+        printf("ordem %u, R=%d: ruído reduzido %.1fx (teórico %.1fx)\n", order, TEMP_DECIMATION, measured, expected);
+        CHECK(measured > expected * 0.85 && measured < expected * 1.15);
+    }
+}
+
+// Rampa de aquecimento do chip (1 LSB por amostra): a saída fica atrasada de
+// ordem*(R-1)/2 amostras, o atraso de grupo do filtro
+static void test_ramp(void) {
+    for (uint32_t i = 0; i < TEMP_RING_SAMPLES; i++) {
+        ring[i] = (uint16_t)(800 + i);
+    }
+    for (uint8_t order = 1; order <= 2; order++) {
+        double gain = pow(TEMP_DECIMATION, order);
+        double y = (order == 1 ? temp_filter_moving_average(ring, RING_MASK, RING_MASK, TEMP_DECIMATION)
+                               : temp_filter_cic(ring, RING_MASK, RING_MASK, order, TEMP_DECIMATION)) / gain;
+        double delay = order * (TEMP_DECIMATION - 1) / 2.0;
+        CHECK(fabs(y - (800 + RING_MASK - delay)) < 1e-9);
+    }
+}
+
+// Interferência periódica com período R/4 (ex.: rajadas do rádio): cai num zero da caixa de R
+static void test_periodic_rejection(void) {
+    for (uint32_t i = 0; i < TEMP_RING_SAMPLES; i++) {
+        ring[i] = adc(1000 + 40 * sin(2 * M_PI * i / (TEMP_DECIMATION / 4.0)));
+    }
+    for (uint8_t order = 1; order <= 2; order++) {
+        double gain = pow(TEMP_DECIMATION, order);
+        double y = (order == 1 ? temp_filter_moving_average(ring, RING_MASK, RING_MASK, TEMP_DECIMATION)
+                               : temp_filter_cic(ring, RING_MASK, RING_MASK, order, TEMP_DECIMATION)) / gain;
+        CHECK(fabs(y - 1000) < 0.5);
+    }
+}
+
+// Custo de cada saída no tamanho do firmware (R = TEMP_DECIMATION, buffer de TEMP_RING_SAMPLES)
+static void benchmark(void) {
+    const int runs = 2000;
+    volatile uint32_t sink = 0;
+    for (uint32_t i = 0; i < TEMP_RING_SAMPLES; i++) {
+        ring[i] = adc(876 + gaussian(4));
+    }
+    for (uint8_t order = 0; order <= TEMP_FILTER_MAX_ORDER; order++) {
+        if (order * TEMP_DECIMATION > TEMP_RING_SAMPLES) {
+            continue;
+        }
+        uint64_t best = UINT64_MAX;
+        for (int n = 0; n < runs; n++) {
+            uint64_t start = test_cycles();
+            sink += order == 0 ? temp_filter_moving_average(ring, RING_MASK, n, TEMP_DECIMATION)
+                               : temp_filter_cic(ring, RING_MASK, n, order, TEMP_DECIMATION);
+            uint64_t spent = test_cycles() - start;
+            best = spent < best ? spent : best;
+        }
+        if (order == 0) {
+            printf("média móvel R=%d: %llu %s/saída\n", TEMP_DECIMATION, (unsigned long long)best, TEST_CYCLES_UNIT);
+        } else {
+            printf("CIC ordem %u R=%d: %llu %s/saída\n", order, TEMP_DECIMATION, (unsigned long long)best, TEST_CYCLES_UNIT);
+        }
+    }
+    (void)sink;
+}
+
+int main(void) {
+    test_against_fir();
+    test_noise_reduction();
+    test_ramp();
+    test_periodic_rejection();
+    benchmark();
+    return test_report("temp_filter");
+}
@@ -0,0 +1,51 @@
+// Gera inc/status_frames.h no diretório de build: um quadro pronto (byte de controle 0x40
+// + framebuffer) para cada tela de status, desenhado com o mesmo inc/ssd1306.c e
+// inc/status_screens.c do firmware. Com --golden <dir>, escreve os quadros de referência.
+#include <stdio.h>
+#include <string.h>
+#include "inc/ssd1306.h"
+#include "inc/status_screens.h"
+#include "status_golden.h"
+
+int main(int argc, char **argv) {
+    if (argc == 3 && strcmp(argv[1], "--golden") == 0) {
+        ssd1306_t ssd;
+        ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, NULL);
+        for (int s = 0; s < STATUS_SCREEN_COUNT; s++) {
+            status_screen_render(&ssd, s);
+            if (!status_golden_write(argv[2], s, ssd.ram_buffer)) {
+                return 1;
+            }
+        }
+        return 0;
+    }
+    if (argc != 2) {
+        fprintf(stderr, "uso: %s <status_frames.h> | --golden <dir>\n", argv[0]);
+        return 1;
+    }
+    FILE *out = fopen(argv[1], "w");
+    if (out == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    ssd1306_t ssd;
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, NULL);
+
+    fprintf(out, "// Gerado por tools/gen_status_frames.c - não editar\n");
+    fprintf(out, "#ifndef STATUS_FRAMES_H\n#define STATUS_FRAMES_H\n\n#include <stdint.h>\n\n");
+    fprintf(out, "#define STATUS_FRAME_SIZE %u\n\n", (unsigned)ssd.bufsize);
+    fprintf(out, "static const uint8_t status_frames[%d][STATUS_FRAME_SIZE] = {\n", STATUS_SCREEN_COUNT);
+    for (int s = 0; s < STATUS_SCREEN_COUNT; s++) {
+        status_screen_render(&ssd, s);
+        fprintf(out, "    { // Tela %d\n", s + STATUS_SCREEN_FIRST);
+        for (size_t i = 0; i < ssd.bufsize; i++) {
+            fprintf(out, "%s0x%02X,%s", i % 16 == 0 ? "        " : "", ssd.ram_buffer[i],
+                    i % 16 == 15 || i == ssd.bufsize - 1 ? "\n" : " ");
+        }
+        fprintf(out, "    },\n");
+    }
+    fprintf(out, "};\n\n#endif\n");
+    fclose(out);
+    return 0;
+}
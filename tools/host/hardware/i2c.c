@@ -0,0 +1,67 @@
+#include <string.h>
+#include "hardware/i2c.h"
+
+#define I2C_MOCK_DEFAULT {.error = PICO_ERROR_GENERIC, .baudrate = 100000}
+
+i2c_mock_t i2c_mock = I2C_MOCK_DEFAULT;
+
+void i2c_mock_reset(void) {
+    i2c_mock = (i2c_mock_t)I2C_MOCK_DEFAULT;
+}
+
+uint i2c_set_baudrate(i2c_inst_t *i2c, uint baudrate) {
+    i2c_mock.baudrate = baudrate;
+    return baudrate;
+}
+
+// Decide se a transação atual falha, pela rajada pedida ou pela faixa da velocidade atual
+static int i2c_mock_fault(size_t len, uint timeout_us) {
+    i2c_mock.transactions++;
+    if (timeout_us != 0 && (uint64_t)len * 9 * 1000000 / i2c_mock.baudrate > timeout_us) {
+        i2c_mock.short_timeouts++;
+    }
+    bool fail = false;
+    if (i2c_mock.fail_next > 0) {
+        i2c_mock.fail_next--;
+        fail = true;
+    } else if (i2c_mock.fail_at != 0) {
+        fail = i2c_mock.transactions == i2c_mock.fail_at;
+    } else if (i2c_mock.bands[0].up_to_hz != 0) {
+        fail = true;
+        for (int i = 0; i < I2C_MOCK_BANDS && i2c_mock.bands[i].up_to_hz != 0; i++) {
+            if (i2c_mock.baudrate <= i2c_mock.bands[i].up_to_hz) {
+                uint32_t one_in = i2c_mock.bands[i].fail_one_in;
+                fail = one_in != 0 && i2c_mock.transactions % one_in == 0;
+                break;
+            }
+        }
+    }
+    if (fail) {
+        i2c_mock.faults++;
+        return i2c_mock.error;
+    }
+    return 0;
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    return i2c_write_timeout_us(i2c, addr, src, len, nostop, 0);
+}
+
+int i2c_write_timeout_us(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop, uint timeout_us) {
+    int fault = i2c_mock_fault(len, timeout_us);
+    if (fault != 0) {
+        return fault;
+    }
+    i2c_mock.last_write_len = len < sizeof(i2c_mock.last_write) ? len : sizeof(i2c_mock.last_write);
+    memcpy(i2c_mock.last_write, src, i2c_mock.last_write_len);
+    return (int)len;
+}
+
+int i2c_read_timeout_us(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop, uint timeout_us) {
+    int fault = i2c_mock_fault(len, timeout_us);
+    if (fault != 0) {
+        return fault;
+    }
+    memset(dst, i2c_mock.status, len);
+    return (int)len;
+}
@@ -0,0 +1,47 @@
+// Substituto do hardware/i2c.h no host: um barramento simulado (tools/host/hardware/i2c.c)
+// que aceita tudo por padrão e, nos testes, injeta NAKs e timeouts conforme a velocidade
+#ifndef HOST_HARDWARE_I2C_H
+#define HOST_HARDWARE_I2C_H
+
+#include "pico/stdlib.h"
+
+#ifndef PICO_ERROR_GENERIC
+#define PICO_ERROR_GENERIC -1       // NAK do endereço ou dos dados
+#define PICO_ERROR_TIMEOUT -2
+#endif
+
+typedef struct i2c_inst i2c_inst_t;
+
+// Faixa de velocidade do simulador: até 'up_to_hz', falha 1 a cada 'fail_one_in' transações
+// (0 = nunca, 1 = sempre). Faixas em ordem crescente; acima da última, sempre falha.
+typedef struct {
+    uint32_t up_to_hz;
+    uint32_t fail_one_in;
+} i2c_mock_band_t;
+
+#define I2C_MOCK_BANDS 4
+
+typedef struct {
+    i2c_mock_band_t bands[I2C_MOCK_BANDS];  // Todas zeradas = barramento perfeito
+    uint32_t fail_next;     // Falha as próximas N transações em qualquer velocidade
+    uint32_t fail_at;       // Falha a transação de número N (contando desde o reset; 0 = nenhuma)
+    int error;              // Código das falhas: PICO_ERROR_GENERIC (padrão) ou PICO_ERROR_TIMEOUT
+    uint8_t status;         // Byte devolvido pelas leituras (status do SSD1306)
+
+    // Observações para os testes
+    uint baudrate;
+    uint32_t transactions, faults;
+    uint32_t short_timeouts;    // Prazos menores que o tempo nominal da transferência
+    uint8_t last_write[1025];   // Última escrita bem-sucedida
+    size_t last_write_len;
+} i2c_mock_t;
+
+extern i2c_mock_t i2c_mock;
+
+void i2c_mock_reset(void);
+uint i2c_set_baudrate(i2c_inst_t *i2c, uint baudrate);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+int i2c_write_timeout_us(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop, uint timeout_us);
+int i2c_read_timeout_us(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop, uint timeout_us);
+
+#endif
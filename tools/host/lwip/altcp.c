@@ -0,0 +1,180 @@
+#include <string.h>
+#include "lwip/altcp.h"
+#include "lwipopts.h"
+
+altcp_fake_t altcp_fake;
+
+static struct altcp_pcb pcbs[ALTCP_FAKE_PCBS];
+static unsigned newest = 0;
+
+// Pool de pbufs do tamanho do firmware, cada um com até TCP_MSS bytes
+static struct pbuf pbuf_pool[PBUF_POOL_SIZE];
+static uint8_t pbuf_data[PBUF_POOL_SIZE][TCP_MSS];
+static bool pbuf_used[PBUF_POOL_SIZE];
+
+void altcp_fake_reset(void) {
+    memset(&altcp_fake, 0, sizeof(altcp_fake));
+    memset(pcbs, 0, sizeof(pcbs));
+    memset(pbuf_used, 0, sizeof(pbuf_used));
+}
+
+static void altcp_fake_free(struct altcp_pcb *conn) {
+    conn->in_use = false;
+    altcp_fake.live--;
+}
+
+struct altcp_pcb *altcp_fake_new(void) {
+    for (unsigned i = 0; i < ALTCP_FAKE_PCBS; i++) {
+        if (!pcbs[i].in_use) {
+            pcbs[i] = (struct altcp_pcb){.id = ++altcp_fake.opened, .in_use = true};
+            newest = i;
+            altcp_fake.live++;
+            altcp_fake.max_live = altcp_fake.live > altcp_fake.max_live ? altcp_fake.live : altcp_fake.max_live;
+            return &pcbs[i];
+        }
+    }
+    altcp_fake.pool_errors++;
+    return NULL;
+}
+
+struct altcp_pcb *altcp_fake_active(void) {
+    return pcbs[newest].in_use ? &pcbs[newest] : NULL;
+}
+
+void altcp_arg(struct altcp_pcb *conn, void *arg) {
+    conn->arg = arg;
+}
+
+void altcp_recv(struct altcp_pcb *conn, altcp_recv_fn recv) {
+    conn->recv = recv;
+}
+
+void altcp_sent(struct altcp_pcb *conn, altcp_sent_fn sent) {
+    conn->sent = sent;
+}
+
+void altcp_poll(struct altcp_pcb *conn, altcp_poll_fn poll, u8_t interval) {
+    conn->poll = poll;
+    conn->poll_interval = interval;
+    conn->poll_ticks = 0;
+}
+
+void altcp_err(struct altcp_pcb *conn, altcp_err_fn err) {
+    conn->err = err;
+}
+
+void altcp_recved(struct altcp_pcb *conn, u16_t len) {
+    conn->recved += len;
+}
+
+err_t altcp_connect(struct altcp_pcb *conn, const ip_addr_t *ipaddr, u16_t port, altcp_connected_fn connected) {
+    if (altcp_fake.fail_connect) {
+        return ERR_VAL;
+    }
+    conn->connected = connected;
+    conn->connecting = true;
+    return ERR_OK;
+}
+
+err_t altcp_write(struct altcp_pcb *conn, const void *dataptr, u16_t len, u8_t apiflags) {
+    conn->written += len;
+    return ERR_OK;
+}
+
+err_t altcp_output(struct altcp_pcb *conn) {
+    return ERR_OK;
+}
+
+err_t altcp_close(struct altcp_pcb *conn) {
+    altcp_fake.closed++;
+    altcp_fake_free(conn);
+    return ERR_OK;
+}
+
+void altcp_abort(struct altcp_pcb *conn) {
+    altcp_fake.aborted++;
+    altcp_fake_free(conn);
+}
+
+u8_t pbuf_free(struct pbuf *p) {
+    u8_t count = 0;
+    while (p != NULL) {
+        struct pbuf *next = p->next;
+        pbuf_used[p - pbuf_pool] = false;
+        altcp_fake.pbufs_live--;
+        p = next;
+        count++;
+    }
+    return count;
+}
+
+err_t altcp_fake_connect_done(struct altcp_pcb *conn) {
+    conn->connecting = false;
+    return conn->connected(conn->arg, conn, ERR_OK);
+}
+
+// Monta uma cadeia com segmentos de até 'segment' bytes (um pbuf do pool cada) e chama o recv.
+// Sem pbufs livres o lwIP descartaria o segmento; aqui isso conta como erro de pool.
+err_t altcp_fake_deliver(struct altcp_pcb *conn, const void *data, size_t len, size_t segment) {
+    struct pbuf *head = NULL, **tail = &head;
+    size_t total = 0;
+    segment = segment > TCP_MSS ? TCP_MSS : segment;
+    while (total < len) {
+        int free_index = -1;
+        for (int i = 0; i < PBUF_POOL_SIZE && free_index < 0; i++) {
+            free_index = pbuf_used[i] ? -1 : i;
+        }
+        if (free_index < 0) {
+            altcp_fake.pool_errors++;
+            break;
+        }
+        size_t n = len - total < segment ? len - total : segment;
+        pbuf_used[free_index] = true;
+        memcpy(pbuf_data[free_index], (const uint8_t *)data + total, n);
+        pbuf_pool[free_index] = (struct pbuf){.payload = pbuf_data[free_index], .len = (u16_t)n};
+        *tail = &pbuf_pool[free_index];
+        tail = &pbuf_pool[free_index].next;
+        total += n;
+        altcp_fake.pbufs_live++;
+        altcp_fake.pbufs_max = altcp_fake.pbufs_live > altcp_fake.pbufs_max ? altcp_fake.pbufs_live : altcp_fake.pbufs_max;
+    }
+    for (struct pbuf *p = head; p != NULL; p = p->next) {
+        p->tot_len = (u16_t)total;
+        total -= p->len;
+    }
+    if (head == NULL) {
+        return ERR_MEM;
+    }
+    if (conn->recv == NULL) {
+        pbuf_free(head);    // Sem callback o lwIP descarta os dados
+        return ERR_OK;
+    }
+    return conn->recv(conn->arg, conn, head, ERR_OK);
+}
+
+err_t altcp_fake_remote_close(struct altcp_pcb *conn) {
+    if (conn->recv == NULL) {
+        return ERR_OK;
+    }
+    return conn->recv(conn->arg, conn, NULL, ERR_OK);
+}
+
+// Erro fatal (RST, falha do handshake): o lwIP libera o PCB antes de chamar o callback
+void altcp_fake_error(struct altcp_pcb *conn, err_t err) {
+    altcp_err_fn callback = conn->err;
+    void *arg = conn->arg;
+    altcp_fake_free(conn);
+    if (callback != NULL) {
+        callback(arg, err);
+    }
+}
+
+void altcp_fake_tick(void) {
+    for (unsigned i = 0; i < ALTCP_FAKE_PCBS; i++) {
+        struct altcp_pcb *conn = &pcbs[i];
+        if (conn->in_use && conn->poll != NULL && ++conn->poll_ticks >= conn->poll_interval) {
+            conn->poll_ticks = 0;
+            conn->poll(conn->arg, conn);
+        }
+    }
+}
@@ -0,0 +1,66 @@
+// Substituto do lwip/altcp.h no host: conexões simuladas (tools/host/lwip/altcp.c) que o teste
+// conduz como se fosse o servidor - completa a conexão, entrega bytes em pbufs, fecha, gera
+// erros e roda o poll do TCP. Conta as conexões e os pbufs vivos para conferir os limites.
+#ifndef HOST_LWIP_ALTCP_H
+#define HOST_LWIP_ALTCP_H
+
+#include "lwip/arch.h"
+#include "lwip/err.h"
+#include "lwip/pbuf.h"
+#include "lwip/ip_addr.h"
+
+#define TCP_WRITE_FLAG_COPY 0x01
+#define ALTCP_FAKE_PCBS 5           // MEMP_NUM_TCP_PCB padrão do lwIP
+
+struct altcp_pcb;
+typedef err_t (*altcp_connected_fn)(void *arg, struct altcp_pcb *conn, err_t err);
+typedef err_t (*altcp_recv_fn)(void *arg, struct altcp_pcb *conn, struct pbuf *p, err_t err);
+typedef err_t (*altcp_sent_fn)(void *arg, struct altcp_pcb *conn, u16_t len);
+typedef err_t (*altcp_poll_fn)(void *arg, struct altcp_pcb *conn);
+typedef void (*altcp_err_fn)(void *arg, err_t err);
+
+struct altcp_pcb {
+    u32_t id;                   // Número da conexão (o PCB do pool é reaproveitado)
+    bool in_use, connecting;
+    void *arg;
+    altcp_connected_fn connected;
+    altcp_recv_fn recv;
+    altcp_sent_fn sent;
+    altcp_poll_fn poll;
+    altcp_err_fn err;
+    u8_t poll_interval, poll_ticks;
+    u32_t written, recved;      // Bytes escritos pela aplicação / janela devolvida
+};
+
+void altcp_arg(struct altcp_pcb *conn, void *arg);
+void altcp_recv(struct altcp_pcb *conn, altcp_recv_fn recv);
+void altcp_sent(struct altcp_pcb *conn, altcp_sent_fn sent);
+void altcp_poll(struct altcp_pcb *conn, altcp_poll_fn poll, u8_t interval);
+void altcp_err(struct altcp_pcb *conn, altcp_err_fn err);
+void altcp_recved(struct altcp_pcb *conn, u16_t len);
+err_t altcp_connect(struct altcp_pcb *conn, const ip_addr_t *ipaddr, u16_t port, altcp_connected_fn connected);
+err_t altcp_write(struct altcp_pcb *conn, const void *dataptr, u16_t len, u8_t apiflags);
+err_t altcp_output(struct altcp_pcb *conn);
+err_t altcp_close(struct altcp_pcb *conn);
+void altcp_abort(struct altcp_pcb *conn);
+
+// Lado do teste
+typedef struct {
+    u32_t opened, closed, aborted, pool_errors;
+    u32_t live, max_live;               // Conexões abertas ao mesmo tempo
+    u32_t pbufs_live, pbufs_max;
+    bool fail_connect;                  // altcp_connect devolve erro
+} altcp_fake_t;
+
+extern altcp_fake_t altcp_fake;
+
+void altcp_fake_reset(void);
+struct altcp_pcb *altcp_fake_new(void);         // No lugar de altcp_tcp_new/altcp_tls_new
+struct altcp_pcb *altcp_fake_active(void);      // Conexão viva (a mais recente), ou NULL
+err_t altcp_fake_connect_done(struct altcp_pcb *conn);
+err_t altcp_fake_deliver(struct altcp_pcb *conn, const void *data, size_t len, size_t segment);
+err_t altcp_fake_remote_close(struct altcp_pcb *conn);
+void altcp_fake_error(struct altcp_pcb *conn, err_t err);
+void altcp_fake_tick(void);                     // Ciclo de 500 ms do TCP: roda o poll devido
+
+#endif
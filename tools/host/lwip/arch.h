@@ -0,0 +1,14 @@
+// Substituto mínimo do lwip/arch.h: tipos inteiros do lwIP
+#ifndef HOST_LWIP_ARCH_H
+#define HOST_LWIP_ARCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+typedef uint8_t u8_t;
+typedef int8_t s8_t;
+typedef uint16_t u16_t;
+typedef uint32_t u32_t;
+
+#endif
@@ -0,0 +1,11 @@
+// Substituto mínimo do lwip/ip_addr.h: só IPv4
+#ifndef HOST_LWIP_IP_ADDR_H
+#define HOST_LWIP_IP_ADDR_H
+
+#include "lwip/arch.h"
+
+typedef struct {
+    u32_t addr;
+} ip_addr_t;
+
+#endif
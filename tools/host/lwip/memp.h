@@ -0,0 +1,12 @@
+// Substituto mínimo do lwip/memp.h: no host só os pools simulados pelo altcp de
+// tools/host/lwip/altcp.c (pbufs e PCBs TCP)
+#ifndef HOST_LWIP_MEMP_H
+#define HOST_LWIP_MEMP_H
+
+typedef enum {
+    MEMP_TCP_PCB,
+    MEMP_PBUF_POOL,
+    MEMP_MAX
+} memp_t;
+
+#endif
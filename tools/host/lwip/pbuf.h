@@ -0,0 +1,17 @@
+// Substituto mínimo do lwip/pbuf.h: pbufs de um pool do tamanho de PBUF_POOL_SIZE, criados pelo
+// altcp simulado (tools/host/lwip/altcp.c) e devolvidos por pbuf_free
+#ifndef HOST_LWIP_PBUF_H
+#define HOST_LWIP_PBUF_H
+
+#include "lwip/arch.h"
+
+struct pbuf {
+    struct pbuf *next;
+    void *payload;
+    u16_t tot_len;
+    u16_t len;
+};
+
+u8_t pbuf_free(struct pbuf *p);
+
+#endif
@@ -0,0 +1,25 @@
+// Substituto mínimo do lwip/stats.h para compilar inc/mem_report.c no host: só as estatísticas
+// de memória, preenchidas pelo teste de estresse (tests/test_mem_stress.c) com os contadores
+// do altcp simulado
+#ifndef HOST_LWIP_STATS_H
+#define HOST_LWIP_STATS_H
+
+#include <stdint.h>
+#include "lwip/memp.h"
+
+struct stats_mem {
+    const char *name;
+    uint16_t err;
+    uint32_t avail;
+    uint32_t used;
+    uint32_t max;
+};
+
+struct stats_ {
+    struct stats_mem mem;
+    struct stats_mem *memp[MEMP_MAX];
+};
+
+extern struct stats_ lwip_stats;
+
+#endif
@@ -0,0 +1,8 @@
+// Substituto mínimo do pico/cyw43_arch.h: no host não há outro contexto disputando o lwIP
+#ifndef HOST_PICO_CYW43_ARCH_H
+#define HOST_PICO_CYW43_ARCH_H
+
+static inline void cyw43_arch_lwip_begin(void) {}
+static inline void cyw43_arch_lwip_end(void) {}
+
+#endif
@@ -0,0 +1,31 @@
+// Substituto mínimo do pico/stdlib.h para compilar os módulos de inc/ no host
+// (ferramentas de geração dos quadros de status e testes)
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <assert.h>
+
+typedef unsigned int uint;
+
+#define hard_assert assert
+
+// Relógio simulado: definido pelo teste que usar as funções de tempo (ex.: tests/test_http_request.c)
+typedef uint64_t absolute_time_t;
+extern uint64_t host_time_us;
+
+static inline absolute_time_t get_absolute_time(void) {
+    return host_time_us;
+}
+
+static inline absolute_time_t make_timeout_time_ms(uint32_t ms) {
+    return host_time_us + ms * 1000ull;
+}
+
+static inline int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to) {
+    return (int64_t)(to - from);
+}
+
+#endif
@@ -0,0 +1,87 @@
+// Quadros de referência das telas de status em texto (tests/fixtures/status_frames): uma linha
+// por linha do display, '#' aceso, '.' apagado e '?' para a área do WIFI_SSID, que muda com a
+// configuração. Escritos uma vez pelo gerador (--golden) e conferidos à mão; depois disso o
+// build e os testes comparam os quadros com eles.
+#ifndef STATUS_GOLDEN_H
+#define STATUS_GOLDEN_H
+
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include "inc/status_screens.h"
+
+#define STATUS_GOLDEN_FONT_HEIGHT 8
+
+// Pixel do quadro (byte de controle 0x40 + memória em modo vertical: 1 + x * 8 + y / 8)
+static inline bool status_golden_pixel(const uint8_t *frame, int x, int y) {
+    return frame[1 + x * 8 + y / 8] >> (y & 7) & 1;
+}
+
+static inline void status_golden_path(char *path, size_t size, const char *dir, int screen) {
+    snprintf(path, size, "%s/status_%d.txt", dir, screen);
+}
+
+// Pixel na linha que mostra o WIFI_SSID (da posição do texto até a borda direita)
+static inline bool status_golden_masked(int index, int x, int y) {
+    for (int i = 0; i < 3; i++) {
+        const status_line_t *line = &status_screens[index].lines[i];
+        if (line->text != NULL && strcmp(line->text, WIFI_SSID) == 0 &&
+            x >= line->x && y >= line->y && y < line->y + STATUS_GOLDEN_FONT_HEIGHT) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static inline bool status_golden_write(const char *dir, int index, const uint8_t *frame) {
+    char path[512];
+    status_golden_path(path, sizeof(path), dir, index + STATUS_SCREEN_FIRST);
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        perror(path);
+        return false;
+    }
+    for (int y = 0; y < HEIGHT; y++) {
+        for (int x = 0; x < WIDTH; x++) {
+            fputc(status_golden_masked(index, x, y) ? '?' : status_golden_pixel(frame, x, y) ? '#' : '.', f);
+        }
+        fputc('\n', f);
+    }
+    fclose(f);
+    return true;
+}
+
+// Compara o quadro com a referência; retorna o número de pixels diferentes (-1 sem referência).
+// As diferenças (até 10) e os problemas da referência vão para 'log' (NULL = sem mensagens).
+static inline int status_golden_compare(const char *dir, int index, const uint8_t *frame, FILE *log) {
+    char path[512], row[WIDTH + 2];
+    status_golden_path(path, sizeof(path), dir, index + STATUS_SCREEN_FIRST);
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        if (log != NULL) {
+            fprintf(log, "%s: não encontrado\n", path);
+        }
+        return -1;
+    }
+    int failures = 0;
+    for (int y = 0; y < HEIGHT; y++) {
+        if (fgets(row, sizeof(row), f) == NULL || strlen(row) < WIDTH) {
+            if (log != NULL) {
+                fprintf(log, "%s: linha %d incompleta\n", path, y + 1);
+            }
+            fclose(f);
+            return -1;
+        }
+        for (int x = 0; x < WIDTH; x++) {
+            if (row[x] != '?' && (row[x] == '#') != status_golden_pixel(frame, x, y)) {
+                if (failures++ < 10 && log != NULL) {
+                    fprintf(log, "tela %d: pixel x=%d y=%d difere de %s\n", index + STATUS_SCREEN_FIRST, x, y, path);
+                }
+            }
+        }
+    }
+    fclose(f);
+    return failures;
+}
+
+#endif
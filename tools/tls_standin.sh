@@ -0,0 +1,49 @@
+#!/bin/sh
+# Servidor TLS local que substitui a API no benchmark do handshake (TLS_BENCHMARK_ROUNDS).
+# Gera uma raiz RSA 4096 própria e um certificado RSA 2048 para api.openweathermap.org
+# (mesmos tamanhos de chave da cadeia real), escreve tls_standin.h com o IP/porta do PC e a
+# raiz em DER, e sobe o openssl s_server com as mesmas suítes do firmware e tickets de sessão.
+#
+# Uso: tools/tls_standin.sh <ip-do-pc> [porta] [diretório]
+# Depois: cmake -DTLS_STANDIN_DIR=<diretório> ... e gravar o firmware; o monitor serial mostra
+# a média dos handshakes completos e retomados e o pico da arena de cada tipo.
+set -e
+
+IP=${1:?uso: $0 <ip-do-pc> [porta] [diretório]}
+PORT=${2:-4433}
+DIR=${3:-build/tls_standin}
+HOST=api.openweathermap.org
+
+mkdir -p "$DIR"
+cd "$DIR"
+
+if [ ! -f ca.pem ]; then
+    openssl req -x509 -newkey rsa:4096 -nodes -days 3650 -sha256 \
+        -subj "/CN=WeatherAssistant Stand-in Root" -keyout ca.key -out ca.pem 2>/dev/null
+    openssl req -newkey rsa:2048 -nodes -sha256 -subj "/CN=$HOST" \
+        -keyout server.key -out server.csr 2>/dev/null
+    printf 'subjectAltName=DNS:%s\n' "$HOST" > server.ext
+    openssl x509 -req -in server.csr -CA ca.pem -CAkey ca.key -CAcreateserial -days 3650 \
+        -sha256 -extfile server.ext -out server.pem 2>/dev/null
+fi
+
+{
+    echo "// Gerado por tools/tls_standin.sh - não editar"
+    echo "#ifndef TLS_STANDIN_H"
+    echo "#define TLS_STANDIN_H"
+    echo
+    echo "#undef SERVER_IP"
+    echo "#define SERVER_IP \"$IP\""
+    echo "#undef SERVER_PORT"
+    echo "#define SERVER_PORT $PORT"
+    echo
+    echo "static const unsigned char ROOT_CA_DER[] = {"
+    openssl x509 -in ca.pem -outform der | od -An -v -tx1 | sed -E 's/ ([0-9a-f]{2})/0x\1, /g; s/^/    /; s/, $/,/'
+    echo "};"
+    echo
+    echo "#endif"
+} > tls_standin.h
+
+echo "tls_standin.h em $(pwd); configure o firmware com -DTLS_STANDIN_DIR=$(pwd)"
+exec openssl s_server -accept "$PORT" -cert server.pem -key server.key -tls1_2 -www \
+    -cipher ECDHE-RSA-CHACHA20-POLY1305:ECDHE-RSA-AES128-GCM-SHA256
@@ -0,0 +1,34 @@
+// Checagem de build: compara cada quadro gerado em status_frames.h, pixel a pixel, com os
+// quadros de referência versionados (tests/fixtures/status_frames). Não redesenha nada, então
+// uma mudança na fonte, no ssd1306.c ou na tabela de telas interrompe o build até a
+// referência ser revista e regerada (gen_status_frames --golden).
+#include <stdio.h>
+#include "status_golden.h"
+#include "status_frames.h"
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        fprintf(stderr, "uso: %s <diretório das referências>\n", argv[0]);
+        return 1;
+    }
+    if (STATUS_FRAME_SIZE != WIDTH * HEIGHT / 8 + 1) {
+        fprintf(stderr, "status_frames.h: tamanho %u, esperado %u\n", STATUS_FRAME_SIZE, WIDTH * HEIGHT / 8 + 1);
+        return 1;
+    }
+
+    int failures = 0;
+    for (int s = 0; s < STATUS_SCREEN_COUNT; s++) {
+        if (status_frames[s][0] != 0x40) {
+            fprintf(stderr, "tela %d: byte de controle 0x%02X\n", s + STATUS_SCREEN_FIRST, status_frames[s][0]);
+            failures++;
+        }
+        int diff = status_golden_compare(argv[1], s, status_frames[s], stderr);
+        failures += diff < 0 ? 1 : diff;
+    }
+    if (failures) {
+        fprintf(stderr, "status_frames.h difere das referências em %s\n", argv[1]);
+        return 1;
+    }
+    printf("status_frames.h confere com as referências (%d telas)\n", STATUS_SCREEN_COUNT);
+    return 0;
+}